@@ -0,0 +1,92 @@
+#include <stdio.h>
+#include <ctype.h>
+
+#include "amount.h"
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define AMOUNT_SIMD_X86 1
+#endif
+
+#define AMOUNT_MAX_DIGITS 16        // at most 10^18 cents after scaling, well inside int64
+
+bool parse_amount(const char *text, Amount *amount) {
+    bool negative = *text == '-';
+    if (*text == '-' || *text == '+') text++;
+
+    Amount units = 0;
+    int digits = 0, decimals = -1;      // -1: no '.' yet
+    for (; *text; text++) {
+        if (*text == '.' && decimals < 0) {
+            decimals = 0;
+            continue;
+        }
+        if (!isdigit((unsigned char)*text) || decimals == 2 || digits == AMOUNT_MAX_DIGITS) return false;
+        units = units * 10 + (*text - '0');
+        digits++;
+        if (decimals >= 0) decimals++;
+    }
+    if (digits == 0) return false;
+    for (int d = decimals < 0 ? 0 : decimals; d < 2; d++) units *= 10;
+    *amount = negative ? -units : units;
+    return true;
+}
+
+void format_amount(Amount amount, char *out, int size) {
+    uint64_t units = amount < 0 ? -(uint64_t)amount : (uint64_t)amount;
+    snprintf(out, size, "%s%llu.%02llu", amount < 0 ? "-" : "",
+             (unsigned long long)(units / AMOUNT_SCALE), (unsigned long long)(units % AMOUNT_SCALE));
+}
+
+static Amount sum_plain(const Amount *amounts, int n) {
+    Amount total = 0;
+    for (int i = 0; i < n; i++) total += amounts[i];
+    return total;
+}
+
+#ifdef AMOUNT_SIMD_X86
+
+// ⚡ AVX2: four 64-bit lanes per register, two accumulators to hide latency
+
+__attribute__((target("avx2")))
+static Amount add_lanes(__m256i v) {
+    __m128i pair = _mm_add_epi64(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    return _mm_cvtsi128_si64(pair) + _mm_extract_epi64(pair, 1);
+}
+
+__attribute__((target("avx2")))
+static Amount sum_avx2(const Amount *amounts, int n) {
+    __m256i a = _mm256_setzero_si256(), b = _mm256_setzero_si256();
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        a = _mm256_add_epi64(a, _mm256_loadu_si256((const __m256i *)&amounts[i]));
+        b = _mm256_add_epi64(b, _mm256_loadu_si256((const __m256i *)&amounts[i + 4]));
+    }
+    return add_lanes(_mm256_add_epi64(a, b)) + sum_plain(amounts + i, n - i);
+}
+
+static bool has_avx2(void) {
+    static int cached = -1;
+    if (cached < 0) cached = __builtin_cpu_supports("avx2") ? 1 : 0;
+    return cached;
+}
+
+Amount amount_sum(const Amount *amounts, int n) {
+    return has_avx2() ? sum_avx2(amounts, n) : sum_plain(amounts, n);
+}
+
+#else
+
+Amount amount_sum(const Amount *amounts, int n) {
+    return sum_plain(amounts, n);
+}
+
+#endif
+
+// Scattered reads are cache-miss bound: an AVX2 gather measured slower
+// than this loop, so there is no SIMD version
+Amount amount_sum_indexed(const Amount *amounts, const int *index, int n) {
+    Amount total = 0;
+    for (int i = 0; i < n; i++) total += amounts[index[i]];
+    return total;
+}
@@ -0,0 +1,26 @@
+#ifndef AMOUNT_H
+#define AMOUNT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// 💵 Amounts are whole cents in a 64-bit integer: sums and comparisons are
+// exact, so no float drift and no tolerance checks.
+typedef int64_t Amount;
+
+#define AMOUNT_SCALE 100            // base units (cents) per coin
+
+// "12.5" -> 1250. At most two decimals; false on anything else.
+bool parse_amount(const char *text, Amount *amount);
+
+// 1250 -> "12.50"
+void format_amount(Amount amount, char *out, int size);
+
+// ⚡ amounts[0] + ... + amounts[n - 1]: AVX2 when the CPU has it (checked
+// once), a plain loop otherwise
+Amount amount_sum(const Amount *amounts, int n);
+
+// amounts[index[0]] + ... + amounts[index[n - 1]]
+Amount amount_sum_indexed(const Amount *amounts, const int *index, int n);
+
+#endif
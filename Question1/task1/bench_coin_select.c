@@ -0,0 +1,122 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "utxo_set.h"
+#include "coin_select.h"
+
+// 🧪 Coin selection benchmark
+//
+// Fills one wallet with many UTXOs of random amounts, then makes the same
+// sequence of payments from it with every strategy. For each one it prints
+// how long select_coins took, how many inputs a payment used, how many
+// payments needed a change output and how many UTXOs the wallet holds at
+// the end (the UTXO-set growth the strategy causes).
+//
+//   ./bench_coin_select [--utxos N] [--payments M] [--seed S]
+
+static uint64_t rng_state;
+
+static uint64_t next_random(void) {
+    uint64_t z = (rng_state += 0x9E3779B97F4A7C15ULL);   // splitmix64
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Random amount in cents between min and max
+static Amount random_amount(int min_cents, int max_cents) {
+    return min_cents + (Amount)(next_random() % (uint64_t)(max_cents - min_cents + 1));
+}
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static int compare_doubles(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static void run_strategy(CoinStrategy strategy, int utxos, int payments, uint64_t seed) {
+    UtxoSet set;
+    CoinSelection selection = {0};
+    double *times = malloc(sizeof(double) * payments);
+    uint32_t txid = 0;
+    long inputs = 0;
+    int changes = 0, failed = 0, made = 0;
+
+    utxo_set_init(&set);
+    int wallet = utxo_set_intern(&set, "WALLET");
+    int shop = utxo_set_intern(&set, "SHOP");
+    rng_state = seed;
+    for (int i = 0; i < utxos; i++) {
+        Outpoint outpoint = { ++txid, 0 };
+        utxo_set_add(&set, outpoint, wallet, random_amount(1, 10000));
+    }
+
+    for (int p = 0; p < payments; p++) {
+        Amount amount = random_amount(100, 20000);
+        double start = now_seconds();
+        bool ok = select_coins(&set, wallet, amount, strategy, &selection);
+        times[made] = now_seconds() - start;
+        if (!ok) {
+            failed++;
+            continue;
+        }
+        made++;
+
+        Amount collected = selection.total;
+        for (int i = 0; i < selection.count; i++) {
+            utxo_set_spend(&set, selection.inputs[i]);
+        }
+        inputs += selection.count;
+
+        Outpoint payment = { ++txid, 0 };
+        utxo_set_add(&set, payment, shop, amount);
+        if (collected > amount) {
+            Outpoint change = { txid, 1 };
+            utxo_set_add(&set, change, wallet, collected - amount);
+            changes++;
+        }
+    }
+
+    if (made > 0) {
+        qsort(times, made, sizeof(double), compare_doubles);
+        printf("%-9s | %9.2f | %9.2f | %9.2f | %6.2f | %7d | %8d | %d\n",
+               coin_strategy_name(strategy),
+               times[made / 2] * 1e6, times[(int)(0.99 * (made - 1))] * 1e6, times[made - 1] * 1e6,
+               (double)inputs / made, changes, utxo_set_address(&set, wallet)->unspent, failed);
+    }
+    coin_selection_free(&selection);
+    free(times);
+    utxo_set_free(&set);
+}
+
+int main(int argc, char *argv[]) {
+    int utxos = 100000, payments = 1000;
+    uint64_t seed = 1;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--utxos") == 0) utxos = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "--payments") == 0) payments = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "--seed") == 0) seed = strtoull(argv[i + 1], NULL, 10);
+    }
+    if (utxos < 1 || payments < 1) {
+        printf("Usage: %s [--utxos N] [--payments M] [--seed S]\n", argv[0]);
+        return 1;
+    }
+
+    printf("🧪 Coin selection: wallet of %d UTXOs (0.01-100.00), %d payments (1.00-200.00)\n\n",
+           utxos, payments);
+    printf("strategy  |  p50 (us) |  p99 (us) |  max (us) | inputs | changes | UTXOs end | failed\n");
+    printf("----------------------------------------------------------------------------------------\n");
+    CoinStrategy strategies[] = { SELECT_OLDEST, SELECT_LARGEST, SELECT_BNB, SELECT_KNAPSACK };
+    for (int s = 0; s < 4; s++) {
+        run_strategy(strategies[s], utxos, payments, seed);
+    }
+    return 0;
+}
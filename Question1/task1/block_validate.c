@@ -0,0 +1,304 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+#include "block_validate.h"
+
+#define VALIDATE_CHUNK 64       // transactions claimed per trip to the shared counter
+
+// 🔒 One outpoint in the lock-free spent-outpoint table
+typedef struct {
+    _Atomic uint64_t key;       // packed outpoint, 0 = empty (txids start at 1)
+    atomic_int owner;           // first transaction to claim it, + 1
+    atomic_bool contested;      // claimed more than once
+    int spender;                // serial pass: transaction that spends it, + 1
+} ClaimSlot;
+
+// 🧠 Shared state for one validation run
+typedef struct {
+    const UtxoSet *set;
+    BlockTx *txs;
+    int count;
+    atomic_int next;            // next unclaimed transaction
+    int *first_input;           // offset of each transaction's inputs in input_slots
+    int *input_slots;           // claim table slot of every input
+    ClaimSlot *claims;
+    uint32_t claim_mask;
+} ValidateJob;
+
+const char *tx_status_message(TxStatus status) {
+    switch (status) {
+        case TX_VALID:           return "valid";
+        case TX_BAD_ADDRESS:     return "invalid address";
+        case TX_SAME_ADDRESS:    return "sender and receiver must be different";
+        case TX_BAD_AMOUNT:      return "amount must be positive";
+        case TX_BAD_INPUT:       return "invalid UTXO";
+        case TX_DUPLICATE_INPUT: return "UTXO selected twice";
+        case TX_INSUFFICIENT:    return "inputs do not cover the amount";
+        case TX_DOUBLE_SPEND:    return "double spend";
+        case TX_DEFERRED:        return "waiting for outputs created earlier in the block";
+        case TX_NO_ROOM:         return "out of memory or a failed write";
+    }
+    return "unknown";
+}
+
+static uint64_t pack_outpoint(Outpoint outpoint) {
+    return ((uint64_t)outpoint.txid << 32) | outpoint.vout;
+}
+
+static uint32_t hash_key(uint64_t x) {
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    return (uint32_t)x;
+}
+
+// Claim `outpoint` for transaction `tx`; returns its slot. Sets *duplicate
+// if `tx` had already claimed it.
+static int claim_outpoint(ValidateJob *job, Outpoint outpoint, int tx, bool *duplicate) {
+    uint64_t key = pack_outpoint(outpoint);
+    uint32_t s = hash_key(key) & job->claim_mask;
+    for (;; s = (s + 1) & job->claim_mask) {
+        ClaimSlot *slot = &job->claims[s];
+        uint64_t current = atomic_load(&slot->key);
+        if (current == 0 && atomic_compare_exchange_strong(&slot->key, &current, key)) {
+            current = key;
+        }
+        if (current != key) continue;
+
+        int expected = 0;
+        if (!atomic_compare_exchange_strong(&slot->owner, &expected, tx + 1)) {
+            if (expected == tx + 1) *duplicate = true;
+            else atomic_store(&slot->contested, true);
+        }
+        return s;
+    }
+}
+
+// 🔍 Everything that can be checked without looking at other transactions.
+// With `defer`, a transaction that needs outputs the set does not hold yet
+// is TX_DEFERRED instead of rejected: they may come from earlier in the block.
+static TxStatus check_tx(const UtxoSet *set, BlockTx *tx, bool defer) {
+    tx->from = utxo_set_lookup(set, tx->sender);
+    tx->to = utxo_set_lookup(set, tx->receiver);
+    tx->collected = 0;
+    if (tx->from < 0 || tx->to < 0) return TX_BAD_ADDRESS;
+    if (tx->from == tx->to) return TX_SAME_ADDRESS;
+    if (tx->amount <= 0) return TX_BAD_AMOUNT;
+    if (tx->input_count == 0 && defer) return TX_DEFERRED;     // coin selection came up short
+
+    for (int k = 0; k < tx->input_count; k++) {
+        int idx = utxo_set_find(set, tx->inputs[k]);
+        if (idx < 0 && defer) return TX_DEFERRED;
+        if (idx < 0 || set->address_ids[idx] != tx->from) return TX_BAD_INPUT;
+        tx->collected += set->amounts[idx];
+    }
+    if (tx->collected < tx->amount) return TX_INSUFFICIENT;
+    return TX_VALID;
+}
+
+static void *validate_worker(void *arg) {
+    ValidateJob *job = arg;
+    for (;;) {
+        int start = atomic_fetch_add(&job->next, VALIDATE_CHUNK);
+        if (start >= job->count) break;
+
+        int stop = start + VALIDATE_CHUNK < job->count ? start + VALIDATE_CHUNK : job->count;
+        for (int i = start; i < stop; i++) {
+            BlockTx *tx = &job->txs[i];
+            tx->status = check_tx(job->set, tx, true);
+            if (tx->status != TX_VALID) continue;
+
+            bool duplicate = false;
+            int *slots = &job->input_slots[job->first_input[i]];
+            for (int k = 0; k < tx->input_count; k++) {
+                slots[k] = claim_outpoint(job, tx->inputs[k], i, &duplicate);
+            }
+            if (duplicate) tx->status = TX_DUPLICATE_INPUT;
+        }
+    }
+    return NULL;
+}
+
+int validate_block(const UtxoSet *set, BlockTx *txs, int count, int threads) {
+    if (count <= 0) return 0;
+    if (threads <= 0) threads = 1;
+
+    ValidateJob job;
+    job.set = set;
+    job.txs = txs;
+    job.count = count;
+    atomic_init(&job.next, 0);
+
+    int total_inputs = 0;
+    job.first_input = malloc(sizeof(int) * count);
+    if (job.first_input) {
+        for (int i = 0; i < count; i++) {
+            job.first_input[i] = total_inputs;
+            total_inputs += txs[i].input_count;
+        }
+    }
+    uint32_t claim_count = 1024;        // power of two, load <= 1/2
+    while (claim_count < 2u * (uint32_t)total_inputs) claim_count *= 2;
+    job.claim_mask = claim_count - 1;
+    job.input_slots = malloc(sizeof(int) * (total_inputs + 1));
+    job.claims = calloc(claim_count, sizeof(ClaimSlot));   // all empty, no owner
+    if (!job.first_input || !job.input_slots || !job.claims) {
+        fprintf(stderr, "❌ Out of memory validating %d transactions\n", count);
+        free(job.first_input);
+        free(job.input_slots);
+        free(job.claims);
+        for (int i = 0; i < count; i++) txs[i].status = TX_BAD_INPUT;
+        return 0;
+    }
+
+    // No point starting more workers than there are chunks
+    int chunks = (count + VALIDATE_CHUNK - 1) / VALIDATE_CHUNK;
+    if (threads > chunks) threads = chunks;
+
+    pthread_t *workers = malloc(sizeof(pthread_t) * threads);
+    int started = 0;
+    if (workers) {
+        // The calling thread is one of the workers
+        for (int i = 1; i < threads; i++) {
+            if (pthread_create(&workers[started], NULL, validate_worker, &job) != 0) break;
+            started++;
+        }
+    }
+    validate_worker(&job);
+    for (int i = 0; i < started; i++) pthread_join(workers[i], NULL);
+    free(workers);
+
+    // ⚖️ Serial pass, in block order. A transaction whose inputs nobody else
+    // claimed is settled already; otherwise the first valid transaction to
+    // reach an input spends it and later ones are double spends.
+    int valid = 0;
+    for (int i = 0; i < count; i++) {
+        BlockTx *tx = &txs[i];
+        if (tx->status != TX_VALID) continue;
+
+        int *slots = &job.input_slots[job.first_input[i]];
+        bool contested = false;
+        for (int k = 0; k < tx->input_count && !contested; k++) {
+            contested = atomic_load_explicit(&job.claims[slots[k]].contested, memory_order_relaxed);
+        }
+        if (contested) {
+            int k = 0;
+            for (; k < tx->input_count; k++) {
+                ClaimSlot *slot = &job.claims[slots[k]];
+                if (slot->spender != 0) {
+                    tx->status = slot->spender == i + 1 ? TX_DUPLICATE_INPUT : TX_DOUBLE_SPEND;
+                    break;
+                }
+                slot->spender = i + 1;
+            }
+            if (tx->status != TX_VALID) {
+                while (--k >= 0) job.claims[slots[k]].spender = 0;
+            }
+        }
+        if (tx->status == TX_VALID) valid++;
+    }
+
+    free(job.first_input);
+    free(job.input_slots);
+    free(job.claims);
+    return valid;
+}
+
+// Give back the coins picked for transactions after `i` with the same
+// sender; they are deferred and pick again at their turn. Returns false if
+// there were none.
+static bool release_later_picks(UtxoSet *set, BlockTx *txs, int i, int count) {
+    bool released = false;
+    for (int j = i + 1; j < count; j++) {
+        BlockTx *later = &txs[j];
+        if (!later->picked || later->from != txs[i].from || later->input_count == 0) continue;
+        if (later->status != TX_VALID && later->status != TX_DOUBLE_SPEND) continue;
+        for (int k = 0; k < later->input_count; k++) utxo_set_unlock(set, later->inputs[k]);
+        free(later->inputs);
+        later->inputs = NULL;
+        later->input_count = 0;
+        later->status = TX_DEFERRED;
+        released = true;
+    }
+    return released;
+}
+
+// 🔁 Deferred transaction `i`, checked against the set as the transactions
+// before it in the block left it
+static TxStatus check_in_order(UtxoSet *set, BlockTx *txs, int i, int count, CoinStrategy strategy) {
+    BlockTx *tx = &txs[i];
+    if (tx->input_count == 0) {
+        CoinSelection selection = {0};
+        bool covered = select_coins(set, tx->from, tx->amount, strategy, &selection);
+        if (!covered && release_later_picks(set, txs, i, count)) {
+            coin_selection_free(&selection);
+            covered = select_coins(set, tx->from, tx->amount, strategy, &selection);
+        }
+        if (!covered) {
+            coin_selection_free(&selection);
+            return TX_INSUFFICIENT;
+        }
+        tx->picked = true;
+        tx->inputs = selection.inputs;
+        tx->input_count = selection.count;
+        tx->collected = selection.total;
+        return TX_VALID;
+    }
+
+    TxStatus status = check_tx(set, tx, false);
+    for (int k = 1; status == TX_VALID && k < tx->input_count; k++) {
+        for (int j = 0; j < k; j++) {
+            if (pack_outpoint(tx->inputs[j]) == pack_outpoint(tx->inputs[k])) return TX_DUPLICATE_INPUT;
+        }
+    }
+    return status;
+}
+
+int apply_block(UtxoSet *set, BlockTx *txs, int count, CoinStrategy strategy, uint32_t *last_txid) {
+    int applied = 0;
+    bool reordered = false;     // a deferred transaction has spent something
+    for (int i = 0; i < count; i++) {
+        BlockTx *tx = &txs[i];
+        bool deferred = tx->status == TX_DEFERRED;
+        if (deferred) {
+            tx->status = check_in_order(set, txs, i, count, strategy);
+        } else if (tx->status == TX_VALID && reordered) {
+            for (int k = 0; k < tx->input_count; k++) {
+                if (utxo_set_find(set, tx->inputs[k]) < 0) {
+                    tx->status = TX_DOUBLE_SPEND;
+                    break;
+                }
+            }
+        }
+
+        Amount change = tx->collected - tx->amount;
+        bool ready = false;
+        if (tx->status == TX_VALID) {
+            // Room for every spend and output first, so nothing fails halfway
+            int owners[2] = { tx->to, tx->from };
+            ready = utxo_set_reserve_spends(set, tx->input_count) &&
+                    utxo_set_reserve_outputs(set, owners, change > 0 ? 2 : 1);
+            for (int k = 0; ready && k < tx->input_count; k++) ready = utxo_set_spend(set, tx->inputs[k]);
+            if (!ready) tx->status = TX_NO_ROOM;
+        }
+        if (!ready) {
+            for (int k = 0; k < tx->input_count; k++) utxo_set_unlock(set, tx->inputs[k]);
+            continue;
+        }
+
+        applied++;
+        if (deferred) reordered = true;
+        uint32_t txid = ++*last_txid;
+        Outpoint payment = { txid, 0 };
+        utxo_set_add(set, payment, tx->to, tx->amount);
+
+        if (change > 0) {
+            Outpoint back = { txid, 1 };
+            utxo_set_add(set, back, tx->from, change);
+        }
+    }
+    return applied;
+}
@@ -0,0 +1,78 @@
+#ifndef BLOCK_VALIDATE_H
+#define BLOCK_VALIDATE_H
+
+#include "utxo_set.h"
+#include "coin_select.h"
+
+// Why a transaction in a block was rejected
+typedef enum {
+    TX_VALID = 0,
+    TX_BAD_ADDRESS,         // unknown sender or receiver
+    TX_SAME_ADDRESS,
+    TX_BAD_AMOUNT,          // amount not positive
+    TX_BAD_INPUT,           // input not in the set, or not the sender's
+    TX_DUPLICATE_INPUT,     // the same input twice
+    TX_INSUFFICIENT,        // inputs do not cover the amount
+    TX_DOUBLE_SPEND,        // input already spent by an earlier transaction of the block
+    TX_DEFERRED,            // set by validate_block: needs outputs the set does not hold yet
+    TX_NO_ROOM              // set by apply_block: out of memory, or the spent archive failed
+} TxStatus;
+
+// One transaction of a block
+typedef struct {
+    char sender[MAX_ADDRESS_LEN];
+    char receiver[MAX_ADDRESS_LEN];
+    Amount amount;
+    Outpoint *inputs;       // owned by the caller
+    int input_count;
+    bool picked;            // inputs came from coin selection, so they may be picked again
+
+    // Filled in by validate_block
+    int from, to;           // address IDs
+    Amount collected;
+    TxStatus status;
+} BlockTx;
+
+const char *tx_status_message(TxStatus status);
+
+// ✅ Validate a block of transactions against `set` with `threads` workers.
+//
+// Workers take chunks of transactions from a shared counter and check
+// addresses, input existence, ownership and amounts, reading the set only.
+// Each valid transaction then claims its inputs in a lock-free
+// spent-outpoint table; an input claimed by one transaction only cannot be
+// a double spend. A short serial pass settles the contested inputs in
+// block order: the first transaction to use an input keeps it and later
+// ones are TX_DOUBLE_SPEND. The set is not changed.
+//
+// A transaction that needs outputs the set does not hold yet (an input
+// that is not found, or no inputs because coin selection could not cover
+// the amount) may be spending payment or change from earlier in the same
+// block. It is marked TX_DEFERRED and left to apply_block.
+//
+// Returns the number of valid transactions, deferred ones not included.
+int validate_block(const UtxoSet *set, BlockTx *txs, int count, int threads);
+
+// Apply the valid transactions of a validated block in order: spend their
+// inputs, create the payment (output 0) and change (output 1) under the
+// next txids. Inputs of rejected transactions are unlocked.
+//
+// Deferred transactions are checked at their place in the block, against
+// the set as the transactions before them left it: named inputs are looked
+// up again, and a transaction with none runs coin selection (`strategy`)
+// there, storing the picked inputs in tx->inputs for the caller to free.
+// If that selection falls short, coins locked for later picked transactions
+// of the same sender are released first and those transactions pick again
+// at their own turn, as they would have one at a time. A valid transaction
+// whose input a deferred one spent first becomes TX_DOUBLE_SPEND. So a
+// block accepts what applying its transactions one at a time would; only
+// the coins that selection picks before the block can differ.
+//
+// Each
+// transaction is applied all or nothing: room for its spends and its new
+// outputs is reserved first, and if that fails (out of memory, or a failed
+// archive write) it is rejected as TX_NO_ROOM with nothing spent or
+// created. Returns the number of transactions applied.
+int apply_block(UtxoSet *set, BlockTx *txs, int count, CoinStrategy strategy, uint32_t *last_txid);
+
+#endif
@@ -0,0 +1,248 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "coin_select.h"
+
+#define BNB_MAX_TRIES 100000
+#define KNAPSACK_CANDIDATES 48      // outputs just below the target that knapsack mixes
+#define KNAPSACK_ITERATIONS 256
+
+static bool push_input(CoinSelection *out, const UtxoSet *set, int index) {
+    if (out->count == out->capacity) {
+        int capacity = out->capacity ? out->capacity * 2 : 16;
+        Outpoint *grown = realloc(out->inputs, sizeof(Outpoint) * capacity);
+        if (!grown) return false;
+        out->inputs = grown;
+        out->capacity = capacity;
+    }
+    out->inputs[out->count++] = set->outpoints[index];
+    out->total += set->amounts[index];
+    return true;
+}
+
+static void clear_selection(CoinSelection *out) {
+    out->count = 0;
+    out->total = 0;
+}
+
+static Amount amount_at(const UtxoSet *set, const AddressIndex *a, int pos) {
+    return set->amounts[a->by_amount[pos]];
+}
+
+// First position at or after `from` in the sorted list whose amount is below `limit`
+static int first_below(const UtxoSet *set, const AddressIndex *a, int from, Amount limit) {
+    int lo = from, hi = a->unspent;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (amount_at(set, a, mid) >= limit) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+// Oldest first: walk the creation-order list
+static bool select_oldest(const UtxoSet *set, const AddressIndex *a, Amount target, CoinSelection *out) {
+    for (int i = a->head; i != -1 && out->total < target; i = set->next_by_address[i]) {
+        if (!push_input(out, set, i)) return false;
+    }
+    return out->total >= target;
+}
+
+// Largest first, starting at sorted position `from`
+static bool select_largest(const UtxoSet *set, const AddressIndex *a, int from, Amount target,
+                           CoinSelection *out) {
+    for (int pos = from; pos < a->unspent && out->total < target; pos++) {
+        if (!push_input(out, set, a->by_amount[pos])) return false;
+    }
+    return out->total >= target;
+}
+
+// Best of many random subsets of values[0..n) reaching `target`, two passes
+// each, as in ApproximateBestSubset. Starts from all of them, which add up
+// to `available`; returns the best total and its members in *best.
+static Amount best_subset(const Amount *values, int n, Amount available, Amount target, uint64_t *best) {
+    *best = n == 64 ? ~0ULL : (1ULL << n) - 1;
+    Amount best_value = available;
+    uint64_t rng = 0x9E3779B97F4A7C15ULL ^ (uint64_t)target;
+    for (int rep = 0; rep < KNAPSACK_ITERATIONS && best_value != target; rep++) {
+        uint64_t included = 0;
+        Amount total = 0;
+        bool reached = false;
+        rng ^= rng << 13;           // one xorshift draw = a coin flip per candidate
+        rng ^= rng >> 7;
+        rng ^= rng << 17;
+        for (int pass = 0; pass < 2 && !reached; pass++) {
+            for (int i = 0; i < n; i++) {
+                bool take = pass == 0 ? (rng >> i) & 1 : !(included & (1ULL << i));
+                if (!take || (included & (1ULL << i))) continue;
+                total += values[i];
+                included |= 1ULL << i;
+                if (total >= target) {
+                    reached = true;
+                    if (total < best_value) {
+                        best_value = total;
+                        *best = included;
+                    }
+                    total -= values[i];
+                    included &= ~(1ULL << i);
+                }
+            }
+        }
+    }
+    return best_value;
+}
+
+// Knapsack (after Bitcoin Core's KnapsackSolver): an exact single output if
+// there is one; otherwise the best of many random subsets of the outputs
+// just below the target, aiming for target + COIN_MIN_CHANGE when the
+// target cannot be hit exactly, unless the smallest larger output is better.
+static bool select_knapsack(const UtxoSet *set, const AddressIndex *a, Amount target, CoinSelection *out) {
+    int smaller = first_below(set, a, 0, target);   // first output < target
+    if (smaller > 0 && amount_at(set, a, smaller - 1) == target) {
+        return push_input(out, set, a->by_amount[smaller - 1]);
+    }
+    int lowest_larger = smaller > 0 ? smaller - 1 : -1;
+
+    Amount values[KNAPSACK_CANDIDATES];
+    int n = 0;
+    Amount available = 0;
+    for (int pos = smaller; pos < a->unspent && n < KNAPSACK_CANDIDATES; pos++, n++) {
+        values[n] = amount_at(set, a, pos);
+        available += values[n];
+    }
+
+    if (available < target) {
+        // The candidates are not enough: one larger output, or many smaller ones
+        if (lowest_larger >= 0) {
+            return push_input(out, set, a->by_amount[lowest_larger]);
+        }
+        return select_largest(set, a, smaller, target, out);
+    }
+
+    // No exact subset: leave at least COIN_MIN_CHANGE of change if the
+    // candidates can, rather than a dust-sized change output
+    uint64_t best;
+    Amount best_value = best_subset(values, n, available, target, &best);
+    if (best_value != target && available >= target + COIN_MIN_CHANGE) {
+        best_value = best_subset(values, n, available, target + COIN_MIN_CHANGE, &best);
+    }
+
+    // The smaller outputs could only leave dust, or the larger one is closer
+    if (lowest_larger >= 0) {
+        Amount larger = amount_at(set, a, lowest_larger);
+        if ((best_value != target && best_value < target + COIN_MIN_CHANGE) || larger <= best_value) {
+            return push_input(out, set, a->by_amount[lowest_larger]);
+        }
+    }
+    for (int i = 0; i < n; i++) {
+        if ((best & (1ULL << i)) && !push_input(out, set, a->by_amount[smaller + i])) return false;
+    }
+    return true;
+}
+
+// Branch and bound (after Bitcoin Core's SelectCoinsBnB): depth-first over
+// the outputs in descending order, looking for a subset whose total lands
+// in [target, target + COIN_EXACT_WINDOW], so no change output is needed.
+// Outputs that would overshoot are jumped over with a binary search rather
+// than tried one by one, branches that cannot reach the target even with
+// every remaining output are cut, and the search gives up after
+// BNB_MAX_TRIES steps.
+static bool select_bnb(const UtxoSet *set, const AddressIndex *a, Amount target, CoinSelection *out) {
+    Amount upper = target + COIN_EXACT_WINDOW;
+    int n = a->unspent;
+    int *stack = malloc(sizeof(int) * n);          // sorted positions included in the branch
+    int *best = malloc(sizeof(int) * n);
+    if (!stack || !best) {
+        free(stack);
+        free(best);
+        return false;
+    }
+    int depth = 0, best_depth = -1;     // -1: nothing found yet
+    Amount value = 0, best_waste = 0;
+
+    int pos = 0;
+    for (int tries = 0; tries < BNB_MAX_TRIES; tries++) {
+        bool backtrack = false;
+        if (value >= target) {
+            backtrack = true;
+            if (best_depth < 0 || value - target < best_waste) {
+                best_waste = value - target;
+                memcpy(best, stack, sizeof(int) * depth);
+                best_depth = depth;
+                if (best_waste == 0) break;
+            }
+        } else {
+            pos = first_below(set, a, pos, upper - value + 1);     // first output that fits
+            // Sorted descending, so the rest add up to at most amount * count;
+            // amount * count < needed, divided out so it cannot overflow
+            if (pos >= n || amount_at(set, a, pos) <= (target - value - 1) / (n - pos)) {
+                backtrack = true;
+            }
+        }
+
+        if (backtrack) {
+            if (depth == 0) break;
+            // Leave out the last output taken, and every equal one after it:
+            // taking one of those instead would repeat the same branch
+            int last = stack[--depth];
+            value -= amount_at(set, a, last);
+            pos = first_below(set, a, last + 1, amount_at(set, a, last));
+        } else {
+            stack[depth++] = pos;
+            value += amount_at(set, a, pos);
+            pos++;
+        }
+    }
+
+    bool found = best_depth >= 0;
+    for (int i = 0; found && i < best_depth; i++) {
+        found = push_input(out, set, a->by_amount[best[i]]);
+    }
+    free(stack);
+    free(best);
+    return found;
+}
+
+bool select_coins(const UtxoSet *set, int address_id, Amount target,
+                  CoinStrategy strategy, CoinSelection *out) {
+    clear_selection(out);
+    const AddressIndex *a = utxo_set_address(set, address_id);
+    if (target <= 0 || a->balance < target) return false;
+
+    bool ok;
+    switch (strategy) {
+        case SELECT_OLDEST: ok = select_oldest(set, a, target, out); break;
+        case SELECT_LARGEST: ok = select_largest(set, a, 0, target, out); break;
+        case SELECT_KNAPSACK: ok = select_knapsack(set, a, target, out); break;
+        default:
+            ok = select_bnb(set, a, target, out);
+            if (!ok) {
+                clear_selection(out);
+                ok = select_knapsack(set, a, target, out);
+            }
+    }
+    if (!ok) clear_selection(out);
+    return ok;
+}
+
+void coin_selection_free(CoinSelection *selection) {
+    free(selection->inputs);
+    memset(selection, 0, sizeof(*selection));
+}
+
+static const char *strategy_names[] = { "oldest", "largest", "bnb", "knapsack" };
+
+bool parse_coin_strategy(const char *name, CoinStrategy *strategy) {
+    for (int i = 0; i < 4; i++) {
+        if (strcmp(name, strategy_names[i]) == 0) {
+            *strategy = (CoinStrategy)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+const char *coin_strategy_name(CoinStrategy strategy) {
+    return strategy_names[strategy];
+}
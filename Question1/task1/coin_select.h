@@ -0,0 +1,43 @@
+#ifndef COIN_SELECT_H
+#define COIN_SELECT_H
+
+#include <stdbool.h>
+
+#include "utxo_set.h"
+
+// Change up to this many base units counts as an exact match for branch and bound
+#define COIN_EXACT_WINDOW 1
+
+// Smallest change worth making (0.10): knapsack avoids leaving less than this
+// (Bitcoin Core's MIN_CHANGE)
+#define COIN_MIN_CHANGE (AMOUNT_SCALE / 10)
+
+// 🪙 Coin selection strategies
+typedef enum {
+    SELECT_OLDEST,          // oldest outputs first (the original behaviour)
+    SELECT_LARGEST,         // largest outputs first: fewest inputs
+    SELECT_BNB,             // branch and bound for a change-free match, else knapsack
+    SELECT_KNAPSACK         // best random subset of the outputs just below the target
+} CoinStrategy;
+
+typedef struct {
+    Outpoint *inputs;
+    int count;
+    int capacity;
+    Amount total;
+} CoinSelection;
+
+// Pick unspent outputs of an interned address worth at least `target`.
+// Works on the address's amount-sorted list, so the cost depends on the
+// outputs it looks at, not on how many the address owns. Returns false (and an empty
+// selection) if the balance is too low.
+bool select_coins(const UtxoSet *set, int address_id, Amount target,
+                  CoinStrategy strategy, CoinSelection *out);
+
+void coin_selection_free(CoinSelection *selection);
+
+// "oldest" | "largest" | "bnb" | "knapsack"
+bool parse_coin_strategy(const char *name, CoinStrategy *strategy);
+const char *coin_strategy_name(CoinStrategy strategy);
+
+#endif
@@ -0,0 +1,130 @@
+#include <stdio.h>
+#include <string.h>
+#include <openssl/sha.h>
+
+#include "utxo_commit.h"
+
+#define MUHASH_BYTES COMMITMENT_STATE_LEN
+#define MUHASH_PRIME_OFFSET 1103717 // prime = 2^3072 - offset
+
+bool utxo_commitment_init(UtxoCommitment *c) {
+    memset(c, 0, sizeof(*c));
+    c->prime = BN_new();
+    c->numerator = BN_new();
+    c->denominator = BN_new();
+    c->element = BN_new();
+    c->ctx = BN_CTX_new();
+    c->mont = BN_MONT_CTX_new();
+    c->cipher = EVP_CIPHER_CTX_new();
+    if (!c->prime || !c->numerator || !c->denominator || !c->element || !c->ctx || !c->mont || !c->cipher ||
+        !BN_set_bit(c->prime, 3072) || !BN_sub_word(c->prime, 1) ||
+        !BN_sub_word(c->prime, MUHASH_PRIME_OFFSET - 1) ||
+        !BN_MONT_CTX_set(c->mont, c->prime, c->ctx)) {
+        utxo_commitment_free(c);
+        return false;
+    }
+
+    // Empty set: 1 / 1
+    BN_one(c->numerator);
+    BN_one(c->denominator);
+    return true;
+}
+
+void utxo_commitment_free(UtxoCommitment *c) {
+    BN_free(c->prime);
+    BN_free(c->numerator);
+    BN_free(c->denominator);
+    BN_free(c->element);
+    BN_MONT_CTX_free(c->mont);
+    BN_CTX_free(c->ctx);
+    EVP_CIPHER_CTX_free(c->cipher);
+    memset(c, 0, sizeof(*c));
+}
+
+// Hash one output to a 3072-bit number: SHA-256 of its serialisation
+// keys a ChaCha20 stream, as in Bitcoin Core's MuHash3072
+static void hash_output(UtxoCommitment *c, Outpoint outpoint, const char *address, Amount amount) {
+    uint8_t data[17 + MAX_ADDRESS_LEN];
+    int len = 0;
+    for (int i = 0; i < 4; i++) data[len++] = (uint8_t)(outpoint.txid >> (8 * i));
+    for (int i = 0; i < 4; i++) data[len++] = (uint8_t)(outpoint.vout >> (8 * i));
+    for (int i = 0; i < 8; i++) data[len++] = (uint8_t)((uint64_t)amount >> (8 * i));
+    int address_len = (int)strlen(address);
+    data[len++] = (uint8_t)address_len;
+    memcpy(&data[len], address, address_len);
+    len += address_len;
+
+    uint8_t key[SHA256_DIGEST_LENGTH];
+    SHA256(data, len, key);
+
+    static const uint8_t zeros[MUHASH_BYTES];
+    static const uint8_t iv[16];
+    uint8_t stream[MUHASH_BYTES];
+    int out_len = 0;
+    EVP_EncryptInit_ex(c->cipher, EVP_chacha20(), NULL, key, iv);
+    EVP_EncryptUpdate(c->cipher, stream, &out_len, zeros, MUHASH_BYTES);
+
+    BN_lebin2bn(stream, MUHASH_BYTES, c->element);
+    if (BN_cmp(c->element, c->prime) >= 0) {
+        BN_sub(c->element, c->element, c->prime);
+    }
+}
+
+void utxo_commitment_update(UtxoCommitment *c, Outpoint outpoint, const char *address,
+                            Amount amount, bool created) {
+    hash_output(c, outpoint, address, amount);
+    BIGNUM *target = created ? c->numerator : c->denominator;
+    BN_mod_mul_montgomery(target, target, c->element, c->mont, c->ctx);
+    if (created) c->created++;
+    else c->spent++;
+}
+
+void utxo_commitment_export(UtxoCommitment *c, uint8_t out[COMMITMENT_STATE_LEN]) {
+    BIGNUM *num = BN_new(), *den = BN_new(), *r = BN_new(), *power = BN_new();
+
+    // numerator / denominator carries R^(spent - created); undo it
+    long shift = c->created - c->spent;
+    BN_one(r);
+    BN_to_montgomery(r, r, c->mont, c->ctx);        // R mod prime
+    if (shift < 0) {
+        BN_mod_inverse(r, r, c->prime, c->ctx);
+        shift = -shift;
+    }
+    BN_set_word(power, (BN_ULONG)shift);
+    BN_mod_exp(r, r, power, c->prime, c->ctx);
+
+    BN_mod_inverse(den, c->denominator, c->prime, c->ctx);
+    BN_mod_mul(num, c->numerator, den, c->prime, c->ctx);
+    BN_mod_mul(num, num, r, c->prime, c->ctx);
+    BN_bn2lebinpad(num, out, MUHASH_BYTES);
+
+    BN_free(num);
+    BN_free(den);
+    BN_free(r);
+    BN_free(power);
+}
+
+bool utxo_commitment_import(UtxoCommitment *c, const uint8_t in[COMMITMENT_STATE_LEN]) {
+    // Outputs never hash to 0, so neither does any product of them
+    if (!BN_lebin2bn(in, MUHASH_BYTES, c->numerator) || BN_is_zero(c->numerator) ||
+        BN_cmp(c->numerator, c->prime) >= 0) {
+        BN_one(c->numerator);
+        return false;
+    }
+    BN_one(c->denominator);
+    c->created = 0;
+    c->spent = 0;
+    return true;
+}
+
+void utxo_commitment_digest(UtxoCommitment *c, uint8_t out[COMMITMENT_LEN]) {
+    uint8_t bytes[MUHASH_BYTES];
+    utxo_commitment_export(c, bytes);
+    SHA256(bytes, MUHASH_BYTES, out);
+}
+
+void format_commitment(const uint8_t digest[COMMITMENT_LEN], char *out, int size) {
+    for (int i = 0; i < COMMITMENT_LEN && 2 * i + 2 < size; i++) {
+        snprintf(out + 2 * i, 3, "%02x", digest[i]);
+    }
+}
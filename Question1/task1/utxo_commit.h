@@ -0,0 +1,56 @@
+#ifndef UTXO_COMMIT_H
+#define UTXO_COMMIT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <openssl/bn.h>
+#include <openssl/evp.h>
+
+#include "utxo_set.h"
+
+#define COMMITMENT_LEN 32
+#define COMMITMENT_STATE_LEN 384    // 3072 bits
+
+// 🔏 Rolling commitment to a UTXO set (MuHash3072)
+//
+// Every unspent output is hashed to a number modulo the prime
+// 2^3072 - 1103717, and the commitment is the product of those numbers.
+// Creating an output multiplies it into `numerator`, spending one
+// multiplies it into `denominator`, so each change costs O(1) and the
+// order of changes does not matter. The 32-byte digest is the SHA-256 of
+// numerator / denominator, so two sets with the same outputs give the same
+// digest however they got there.
+//
+// Updates use one Montgomery multiplication each, which also multiplies in
+// R^-1 (R = 2^3072); the digest puts those factors back, using the update
+// counts.
+struct UtxoCommitment {
+    BIGNUM *prime;
+    BIGNUM *numerator;      // product of created outputs * R^-created
+    BIGNUM *denominator;    // product of spent outputs * R^-spent
+    long created;
+    long spent;
+    BIGNUM *element;
+    BN_MONT_CTX *mont;
+    BN_CTX *ctx;
+    EVP_CIPHER_CTX *cipher;
+};
+
+bool utxo_commitment_init(UtxoCommitment *c);
+void utxo_commitment_free(UtxoCommitment *c);
+
+// An output was created (`created`) or spent
+void utxo_commitment_update(UtxoCommitment *c, Outpoint outpoint, const char *address,
+                            Amount amount, bool created);
+
+void utxo_commitment_digest(UtxoCommitment *c, uint8_t out[COMMITMENT_LEN]);
+
+// The accumulated numerator / denominator as one 384-byte little-endian
+// number; the digest is its SHA-256. Importing it into a fresh commitment
+// carries on from there without folding every output in again.
+void utxo_commitment_export(UtxoCommitment *c, uint8_t out[COMMITMENT_STATE_LEN]);
+bool utxo_commitment_import(UtxoCommitment *c, const uint8_t in[COMMITMENT_STATE_LEN]);
+
+void format_commitment(const uint8_t digest[COMMITMENT_LEN], char *out, int size);
+
+#endif
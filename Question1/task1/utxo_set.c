@@ -0,0 +1,625 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+#include "utxo_set.h"
+#include "utxo_commit.h"
+
+// Hash helpers
+static uint32_t hash_outpoint(Outpoint outpoint) {
+    uint64_t x = ((uint64_t)outpoint.txid << 32) | outpoint.vout;
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    return (uint32_t)x;
+}
+
+static uint32_t hash_address(const char *address) {
+    uint32_t h = 2166136261u;   // FNV-1a
+    for (; *address; address++) {
+        h ^= (unsigned char)*address;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static bool same_outpoint(Outpoint a, Outpoint b) {
+    return a.txid == b.txid && a.vout == b.vout;
+}
+
+static int *new_slots(int count) {
+    int *slots = malloc(sizeof(int) * count);
+    if (slots) {
+        memset(slots, 0xff, sizeof(int) * count);   // all -1
+    }
+    return slots;
+}
+
+static bool archive_flush(SpentArchive *archive);
+
+void utxo_set_init(UtxoSet *set) {
+    memset(set, 0, sizeof(*set));
+}
+
+void utxo_set_free(UtxoSet *set) {
+    if (set->commitment) {
+        utxo_commitment_free(set->commitment);
+        free(set->commitment);
+    }
+    for (int i = 0; i < set->address_count; i++) {
+        free(set->addresses[i].by_amount);
+    }
+    if (set->spent.file) {
+        archive_flush(&set->spent);
+        fclose(set->spent.file);
+    }
+    free(set->spent.records);
+    free(set->outpoints);
+    free(set->amounts);
+    free(set->address_ids);
+    free(set->prev_by_address);
+    free(set->next_by_address);
+    free(set->locked);
+    free(set->outpoint_slots);
+    free(set->addresses);
+    free(set->address_slots);
+    utxo_set_init(set);
+}
+
+// Resize every entry array to `capacity` entries. A failed realloc leaves
+// that array as it was, so on failure the set is still usable at its old
+// capacity.
+static bool resize_entries(UtxoSet *set, int capacity) {
+    bool ok = true;
+#define RESIZE_FIELD(field) do { \
+        void *resized = realloc(set->field, sizeof(*set->field) * capacity); \
+        if (resized) set->field = resized; \
+        else ok = false; \
+    } while (0)
+    RESIZE_FIELD(outpoints);
+    RESIZE_FIELD(amounts);
+    RESIZE_FIELD(address_ids);
+    RESIZE_FIELD(prev_by_address);
+    RESIZE_FIELD(next_by_address);
+    RESIZE_FIELD(locked);
+#undef RESIZE_FIELD
+    // Shrinking never fails in a way that matters: the old arrays are larger
+    if (ok || capacity < set->capacity) set->capacity = capacity;
+    return ok;
+}
+
+// Rebuild the outpoint table with `count` slots
+static bool resize_outpoint_slots(UtxoSet *set, int count) {
+    int *slots = new_slots(count);
+    if (!slots) return false;
+
+    for (int i = 0; i < set->count; i++) {
+        uint32_t s = hash_outpoint(set->outpoints[i]) & (count - 1);
+        while (slots[s] != -1) s = (s + 1) & (count - 1);
+        slots[s] = i;
+    }
+    free(set->outpoint_slots);
+    set->outpoint_slots = slots;
+    set->outpoint_slot_count = count;
+    return true;
+}
+
+static bool grow_address_slots(UtxoSet *set) {
+    int count = set->address_slot_count ? set->address_slot_count * 2 : 256;
+    int *slots = new_slots(count);
+    if (!slots) return false;
+
+    for (int i = 0; i < set->address_count; i++) {
+        uint32_t s = hash_address(set->addresses[i].address) & (count - 1);
+        while (slots[s] != -1) s = (s + 1) & (count - 1);
+        slots[s] = i;
+    }
+    free(set->address_slots);
+    set->address_slots = slots;
+    set->address_slot_count = count;
+    return true;
+}
+
+static int find_address(const UtxoSet *set, const char *address) {
+    if (set->address_slot_count == 0) return -1;
+    uint32_t mask = set->address_slot_count - 1;
+    for (uint32_t s = hash_address(address) & mask; set->address_slots[s] != -1; s = (s + 1) & mask) {
+        if (strcmp(set->addresses[set->address_slots[s]].address, address) == 0) {
+            return set->address_slots[s];
+        }
+    }
+    return -1;
+}
+
+int utxo_set_intern(UtxoSet *set, const char *address) {
+    int found = find_address(set, address);
+    if (found >= 0) return found;
+
+    if ((set->address_count + 1) * 2 > set->address_slot_count && !grow_address_slots(set)) return -1;
+    if (set->address_count == set->address_capacity) {
+        int capacity = set->address_capacity ? set->address_capacity * 2 : 64;
+        AddressIndex *grown = realloc(set->addresses, sizeof(AddressIndex) * capacity);
+        if (!grown) return -1;
+        set->addresses = grown;
+        set->address_capacity = capacity;
+    }
+
+    int id = set->address_count++;
+    AddressIndex *a = &set->addresses[id];
+    snprintf(a->address, MAX_ADDRESS_LEN, "%s", address);
+    a->head = a->tail = -1;
+    a->unspent = 0;
+    a->balance = 0;
+    a->by_amount = NULL;
+    a->by_amount_capacity = 0;
+
+    uint32_t mask = set->address_slot_count - 1;
+    uint32_t s = hash_address(address) & mask;
+    while (set->address_slots[s] != -1) s = (s + 1) & mask;
+    set->address_slots[s] = id;
+    return id;
+}
+
+// First position in `a->by_amount` whose amount is below `amount`
+static int amount_position(const UtxoSet *set, const AddressIndex *a, Amount amount) {
+    int lo = 0, hi = a->unspent;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (set->amounts[a->by_amount[mid]] >= amount) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+int utxo_set_lookup(const UtxoSet *set, const char *address) {
+    return find_address(set, address);
+}
+
+// Room in `a`'s amount list for `extra` more outputs
+static bool reserve_by_amount(AddressIndex *a, int extra) {
+    if (a->unspent + extra <= a->by_amount_capacity) return true;
+    int capacity = a->by_amount_capacity ? a->by_amount_capacity * 2 : 8;
+    while (capacity < a->unspent + extra) capacity *= 2;
+    int *grown = realloc(a->by_amount, sizeof(int) * capacity);
+    if (!grown) return false;
+    a->by_amount = grown;
+    a->by_amount_capacity = capacity;
+    return true;
+}
+
+static bool outpoint_before(Outpoint a, Outpoint b) {
+    return a.txid < b.txid || (a.txid == b.txid && a.vout < b.vout);
+}
+
+// Put entry `index` into its owner's oldest-first list and count it. New
+// outputs have the highest txid, so the list walk stops at once for them.
+static void link_by_age(UtxoSet *set, int index) {
+    AddressIndex *a = &set->addresses[set->address_ids[index]];
+    int prev = a->tail;
+    while (prev >= 0 && outpoint_before(set->outpoints[index], set->outpoints[prev])) {
+        prev = set->prev_by_address[prev];
+    }
+    int next = prev >= 0 ? set->next_by_address[prev] : a->head;
+    set->prev_by_address[index] = prev;
+    set->next_by_address[index] = next;
+    if (prev >= 0) set->next_by_address[prev] = index;
+    else a->head = index;
+    if (next >= 0) set->prev_by_address[next] = index;
+    else a->tail = index;
+    a->unspent++;
+    a->balance += set->amounts[index];
+}
+
+// Make entry `index` spendable by its owner: sorted into by_amount (room
+// already reserved) and into the oldest-first list
+static void link_output(UtxoSet *set, int index) {
+    AddressIndex *a = &set->addresses[set->address_ids[index]];
+
+    // Sorted insert (equal amounts keep creation order)
+    int pos = amount_position(set, a, set->amounts[index]);
+    memmove(&a->by_amount[pos + 1], &a->by_amount[pos], sizeof(int) * (a->unspent - pos));
+    a->by_amount[pos] = index;
+    link_by_age(set, index);
+}
+
+static void insert_slot(UtxoSet *set, int index) {
+    uint32_t mask = set->outpoint_slot_count - 1;
+    uint32_t s = hash_outpoint(set->outpoints[index]) & mask;
+    while (set->outpoint_slots[s] != -1) s = (s + 1) & mask;
+    set->outpoint_slots[s] = index;
+}
+
+// Fill entry `index` with a new, unlocked output
+static void set_entry(UtxoSet *set, int index, Outpoint outpoint, int address_id, Amount amount) {
+    set->outpoints[index] = outpoint;
+    set->amounts[index] = amount;
+    set->address_ids[index] = address_id;
+    set->locked[index] = false;
+}
+
+bool utxo_set_reserve_outputs(UtxoSet *set, const int *address_ids, int count) {
+    for (int i = 0; i < count; i++) {
+        if (!reserve_by_amount(&set->addresses[address_ids[i]], count)) return false;
+    }
+    // Same thresholds utxo_set_add grows at
+    int slots = set->outpoint_slot_count ? set->outpoint_slot_count : 1024;
+    while ((set->count + count) * 2 > slots) slots *= 2;
+    if (slots != set->outpoint_slot_count && !resize_outpoint_slots(set, slots)) return false;
+    int capacity = set->capacity ? set->capacity : 1024;
+    while (capacity < set->count + count) capacity *= 2;
+    return capacity == set->capacity || resize_entries(set, capacity);
+}
+
+int utxo_set_add(UtxoSet *set, Outpoint outpoint, int address_id, Amount amount) {
+    if (!reserve_by_amount(&set->addresses[address_id], 1)) return -1;
+    // Twice the slots keeps the load <= 1/2
+    if ((set->count + 1) * 2 > set->outpoint_slot_count &&
+        !resize_outpoint_slots(set, set->outpoint_slot_count ? set->outpoint_slot_count * 2 : 1024)) {
+        return -1;
+    }
+    if (set->count == set->capacity && !resize_entries(set, set->capacity ? set->capacity * 2 : 1024)) {
+        return -1;
+    }
+
+    int index = set->count++;
+    set_entry(set, index, outpoint, address_id, amount);
+    link_output(set, index);
+    insert_slot(set, index);
+
+    if (set->commitment) {
+        utxo_commitment_update(set->commitment, outpoint, set->addresses[address_id].address, amount, true);
+    }
+    return index;
+}
+
+// Slot holding `outpoint`, or -1
+static int find_slot(const UtxoSet *set, Outpoint outpoint) {
+    if (set->outpoint_slot_count == 0) return -1;
+    uint32_t mask = set->outpoint_slot_count - 1;
+    for (uint32_t s = hash_outpoint(outpoint) & mask; set->outpoint_slots[s] != -1; s = (s + 1) & mask) {
+        if (same_outpoint(set->outpoints[set->outpoint_slots[s]], outpoint)) {
+            return s;
+        }
+    }
+    return -1;
+}
+
+int utxo_set_find(const UtxoSet *set, Outpoint outpoint) {
+    int slot = find_slot(set, outpoint);
+    return slot >= 0 ? set->outpoint_slots[slot] : -1;
+}
+
+static const UtxoSet *sorting_set;      // qsort has no context argument
+
+// Largest amount first, equal amounts in creation order (as link_output keeps them)
+static int compare_by_amount(const void *a, const void *b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    Amount ax = sorting_set->amounts[x], ay = sorting_set->amounts[y];
+    if (ax != ay) return ax > ay ? -1 : 1;
+    Outpoint ox = sorting_set->outpoints[x], oy = sorting_set->outpoints[y];
+    return outpoint_before(ox, oy) ? -1 : outpoint_before(oy, ox);
+}
+
+// Forward declaration: defined with the other commitment helpers below
+static bool build_commitment(const UtxoSet *set, UtxoCommitment *c);
+
+bool utxo_set_load(UtxoSet *set, const SavedOutput *outputs, long count, const uint8_t *commitment_state) {
+    if (set->count != 0 || count < 0 || count > INT_MAX / 4) return false;
+
+    int capacity = 1024, slot_count = 1024;
+    while (capacity < count) capacity *= 2;
+    while (slot_count < 2 * count) slot_count *= 2;
+    if (capacity > set->capacity && !resize_entries(set, capacity)) return false;
+    if (slot_count > set->outpoint_slot_count && !resize_outpoint_slots(set, slot_count)) return false;
+
+    // Unsorted appends now, one sort per address afterwards
+    uint32_t mask = set->outpoint_slot_count - 1;
+    for (long i = 0; i < count; i++) {
+        const SavedOutput *o = &outputs[i];
+        if (o->address_id < 0 || o->address_id >= set->address_count) return false;
+        AddressIndex *a = &set->addresses[o->address_id];
+        if (!reserve_by_amount(a, 1)) return false;
+
+        // One probe finds both a repeat and the free slot
+        uint32_t s = hash_outpoint(o->outpoint) & mask;
+        for (; set->outpoint_slots[s] != -1; s = (s + 1) & mask) {
+            if (same_outpoint(set->outpoints[set->outpoint_slots[s]], o->outpoint)) return false;
+        }
+
+        int index = set->count++;
+        set_entry(set, index, o->outpoint, o->address_id, o->amount);
+        a->by_amount[a->unspent] = index;
+        link_by_age(set, index);
+        set->outpoint_slots[s] = index;
+    }
+    sorting_set = set;
+    for (int i = 0; i < set->address_count; i++) {
+        AddressIndex *a = &set->addresses[i];
+        qsort(a->by_amount, a->unspent, sizeof(int), compare_by_amount);
+    }
+
+    if (!set->commitment) return true;
+    if (commitment_state) return utxo_commitment_import(set->commitment, commitment_state);
+    UtxoCommitment rebuilt;
+    if (!build_commitment(set, &rebuilt)) return false;
+    utxo_commitment_free(set->commitment);
+    *set->commitment = rebuilt;
+    return true;
+}
+
+// Empty a slot and shift later entries of the probe run back into the gap,
+// so lookups never stop early at it (no tombstones needed)
+static void remove_slot(UtxoSet *set, uint32_t hole) {
+    uint32_t mask = set->outpoint_slot_count - 1;
+    set->outpoint_slots[hole] = -1;
+    for (uint32_t s = (hole + 1) & mask; set->outpoint_slots[s] != -1; s = (s + 1) & mask) {
+        uint32_t home = hash_outpoint(set->outpoints[set->outpoint_slots[s]]) & mask;
+        if (((s - home) & mask) >= ((s - hole) & mask)) {   // the hole lies on its probe path
+            set->outpoint_slots[hole] = set->outpoint_slots[s];
+            set->outpoint_slots[s] = -1;
+            hole = s;
+        }
+    }
+}
+
+// Position of entry `index` in its owner's by_amount list
+static int by_amount_position(const UtxoSet *set, const AddressIndex *a, int index) {
+    // Outputs with the same amount sit just before amount_position()
+    int pos = amount_position(set, a, set->amounts[index]) - 1;
+    while (a->by_amount[pos] != index) pos--;
+    return pos;
+}
+
+static bool archive_flush(SpentArchive *archive) {
+    if (!archive->file || archive->count == 0) return true;
+    if (fwrite(archive->records, sizeof(SpentOutput), archive->count, archive->file) != (size_t)archive->count) {
+        return false;
+    }
+    archive->written += archive->count;
+    archive->count = 0;
+    return true;
+}
+
+// Make sure `count` more records fit: flush to the file, or grow the buffer
+static bool archive_reserve(SpentArchive *archive, int count) {
+    if (archive->capacity - archive->count >= count) return true;
+    if (archive->file) {
+        if (!archive_flush(archive)) return false;
+        if (archive->capacity >= count) return true;
+    }
+    int capacity = archive->capacity ? archive->capacity * 2 : 1024;
+    while (capacity - archive->count < count) capacity *= 2;
+    SpentOutput *grown = realloc(archive->records, sizeof(SpentOutput) * capacity);
+    if (!grown) return false;
+    archive->records = grown;
+    archive->capacity = capacity;
+    return true;
+}
+
+static bool archive_append(SpentArchive *archive, const UtxoSet *set, int index) {
+    if (!archive_reserve(archive, 1)) return false;
+    SpentOutput *record = &archive->records[archive->count++];
+    memset(record, 0, sizeof(*record));     // padding is written to the archive file
+    record->outpoint = set->outpoints[index];
+    record->amount = set->amounts[index];
+    record->address_id = set->address_ids[index];
+    return true;
+}
+
+// Take entry `index` out of its owner's spendable lists
+static void unlink_output(UtxoSet *set, int index) {
+    AddressIndex *a = &set->addresses[set->address_ids[index]];
+    int pos = by_amount_position(set, a, index);
+    memmove(&a->by_amount[pos], &a->by_amount[pos + 1], sizeof(int) * (a->unspent - pos - 1));
+
+    int prev = set->prev_by_address[index], next = set->next_by_address[index];
+    if (prev >= 0) set->next_by_address[prev] = next;
+    else a->head = next;
+    if (next >= 0) set->prev_by_address[next] = prev;
+    else a->tail = prev;
+    set->prev_by_address[index] = set->next_by_address[index] = -1;
+    a->unspent--;
+    a->balance -= set->amounts[index];
+}
+
+bool utxo_set_reserve_spends(UtxoSet *set, int count) {
+    return archive_reserve(&set->spent, count);
+}
+
+bool utxo_set_spend(UtxoSet *set, Outpoint outpoint) {
+    int slot = find_slot(set, outpoint);
+    if (slot < 0) return false;
+    int index = set->outpoint_slots[slot];
+    if (!archive_append(&set->spent, set, index)) return false;
+    if (set->commitment) {
+        utxo_commitment_update(set->commitment, set->outpoints[index],
+                               set->addresses[set->address_ids[index]].address, set->amounts[index], false);
+    }
+
+    if (set->locked[index]) set->locked_total -= set->amounts[index];
+    else unlink_output(set, index);
+    remove_slot(set, slot);
+
+    // Keep entries dense: the last entry moves into the hole
+    int last = --set->count;
+    if (index != last) {
+        AddressIndex *owner = &set->addresses[set->address_ids[last]];
+        set->outpoint_slots[find_slot(set, set->outpoints[last])] = index;
+        if (!set->locked[last]) {
+            int prev = set->prev_by_address[last], next = set->next_by_address[last];
+            owner->by_amount[by_amount_position(set, owner, last)] = index;
+            if (prev >= 0) set->next_by_address[prev] = index;
+            else owner->head = index;
+            if (next >= 0) set->prev_by_address[next] = index;
+            else owner->tail = index;
+        }
+        set->outpoints[index] = set->outpoints[last];
+        set->amounts[index] = set->amounts[last];
+        set->address_ids[index] = set->address_ids[last];
+        set->prev_by_address[index] = set->prev_by_address[last];
+        set->next_by_address[index] = set->next_by_address[last];
+        set->locked[index] = set->locked[last];
+    }
+
+    // Give memory back once the live set has shrunk a lot (best effort)
+    if (set->capacity > 1024 && set->count < set->capacity / 4) {
+        resize_entries(set, set->capacity / 2);
+    }
+    if (set->outpoint_slot_count > 1024 && set->count * 8 < set->outpoint_slot_count) {
+        resize_outpoint_slots(set, set->outpoint_slot_count / 2);
+    }
+    return true;
+}
+
+bool utxo_set_lock(UtxoSet *set, Outpoint outpoint) {
+    int index = utxo_set_find(set, outpoint);
+    if (index < 0 || set->locked[index]) return false;
+    unlink_output(set, index);
+    set->locked[index] = true;
+    set->locked_total += set->amounts[index];
+    return true;
+}
+
+bool utxo_set_unlock(UtxoSet *set, Outpoint outpoint) {
+    int index = utxo_set_find(set, outpoint);
+    if (index < 0 || !set->locked[index]) return false;
+    if (!reserve_by_amount(&set->addresses[set->address_ids[index]], 1)) return false;
+    set->locked[index] = false;
+    set->locked_total -= set->amounts[index];
+    link_output(set, index);
+    return true;
+}
+
+// Fold every live output into a fresh commitment
+static bool build_commitment(const UtxoSet *set, UtxoCommitment *c) {
+    if (!utxo_commitment_init(c)) return false;
+    for (int i = 0; i < set->count; i++) {
+        utxo_commitment_update(c, set->outpoints[i], set->addresses[set->address_ids[i]].address,
+                               set->amounts[i], true);
+    }
+    return true;
+}
+
+bool utxo_set_enable_commitment(UtxoSet *set) {
+    if (set->commitment) return true;
+    UtxoCommitment *c = malloc(sizeof(UtxoCommitment));
+    if (!c || !build_commitment(set, c)) {
+        free(c);
+        return false;
+    }
+    set->commitment = c;
+    return true;
+}
+
+bool utxo_set_commitment(UtxoSet *set, uint8_t digest[COMMITMENT_LEN]) {
+    if (!set->commitment) return false;
+    utxo_commitment_digest(set->commitment, digest);
+    return true;
+}
+
+bool utxo_set_commitment_state(UtxoSet *set, uint8_t state[COMMITMENT_STATE_LEN]) {
+    if (set->commitment) {
+        utxo_commitment_export(set->commitment, state);
+        return true;
+    }
+    UtxoCommitment fresh;
+    if (!build_commitment(set, &fresh)) return false;
+    utxo_commitment_export(&fresh, state);
+    utxo_commitment_free(&fresh);
+    return true;
+}
+
+bool utxo_set_check_commitment(UtxoSet *set) {
+    uint8_t rolling[COMMITMENT_LEN], rebuilt[COMMITMENT_LEN];
+    UtxoCommitment fresh;
+    if (!utxo_set_commitment(set, rolling) || !build_commitment(set, &fresh)) return false;
+    utxo_commitment_digest(&fresh, rebuilt);
+    utxo_commitment_free(&fresh);
+    return memcmp(rolling, rebuilt, COMMITMENT_LEN) == 0;
+}
+
+bool utxo_set_archive_to(UtxoSet *set, const char *path) {
+    FILE *file = fopen(path, "w+b");
+    if (!file) return false;
+    SpentArchive *archive = &set->spent;
+    if (archive->file) {
+        fclose(archive->file);
+    }
+    archive->file = file;
+    archive->written = 0;
+
+    // From now on the buffer has a fixed size
+    if (archive->capacity < SPENT_BUFFER_RECORDS) {
+        SpentOutput *grown = realloc(archive->records, sizeof(SpentOutput) * SPENT_BUFFER_RECORDS);
+        if (!grown) return false;
+        archive->records = grown;
+        archive->capacity = SPENT_BUFFER_RECORDS;
+    }
+    return archive_flush(archive);
+}
+
+long utxo_set_spent_count(const UtxoSet *set) {
+    return set->spent.written + set->spent.count;
+}
+
+bool utxo_set_each_spent(UtxoSet *set, SpentVisitor visit, void *context) {
+    SpentArchive *archive = &set->spent;
+    if (archive->file && archive->written > 0) {
+        SpentOutput chunk[256];
+        if (fflush(archive->file) != 0 || fseek(archive->file, 0, SEEK_SET) != 0) return false;
+        for (long left = archive->written; left > 0;) {
+            size_t want = left < 256 ? (size_t)left : 256;
+            size_t got = fread(chunk, sizeof(SpentOutput), want, archive->file);
+            for (size_t i = 0; i < got; i++) visit(&chunk[i], context);
+            if (got != want) return false;
+            left -= got;
+        }
+        if (fseek(archive->file, 0, SEEK_END) != 0) return false;
+    }
+    for (int i = 0; i < archive->count; i++) {
+        visit(&archive->records[i], context);
+    }
+    return true;
+}
+
+const AddressIndex *utxo_set_address(const UtxoSet *set, int address_id) {
+    return &set->addresses[address_id];
+}
+
+int utxo_set_first(const UtxoSet *set, int address_id) {
+    return set->addresses[address_id].head;
+}
+
+Amount utxo_set_balance(const UtxoSet *set, int address_id) {
+    return set->addresses[address_id].balance;
+}
+
+Amount utxo_set_total_supply(const UtxoSet *set) {
+    return amount_sum(set->amounts, set->count);
+}
+
+bool utxo_set_audit(const UtxoSet *set, Amount *supply) {
+    *supply = utxo_set_total_supply(set);
+    Amount listed = set->locked_total;
+    for (int i = 0; i < set->address_count; i++) {
+        const AddressIndex *a = &set->addresses[i];
+        Amount owned = amount_sum_indexed(set->amounts, a->by_amount, a->unspent);
+        if (owned != a->balance) return false;
+        listed += owned;
+    }
+    return listed == *supply;
+}
+
+bool parse_outpoint(const char *text, Outpoint *outpoint) {
+    unsigned txid, vout;
+    int used = 0;
+    if (sscanf(text, "TX%u:%u%n", &txid, &vout, &used) != 2 || text[used] != '\0') return false;
+    outpoint->txid = txid;
+    outpoint->vout = vout;
+    return true;
+}
+
+void format_outpoint(Outpoint outpoint, char *out, int size) {
+    snprintf(out, size, "TX%u:%u", outpoint.txid, outpoint.vout);
+}
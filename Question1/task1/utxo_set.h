@@ -0,0 +1,195 @@
+#ifndef UTXO_SET_H
+#define UTXO_SET_H
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "amount.h"
+
+#define MAX_ADDRESS_LEN 20
+
+// Outpoint: output `vout` of transaction TX<txid>, written "TX<txid>:<vout>"
+typedef struct {
+    uint32_t txid;
+    uint32_t vout;
+} Outpoint;
+
+// 📚 Spent archive record
+typedef struct {
+    Outpoint outpoint;
+    Amount amount;
+    int address_id;
+} SpentOutput;
+
+#define SPENT_BUFFER_RECORDS 4096   // records held in memory when archiving to a file
+
+// Append-only history of spent outputs. Without a file every record stays
+// in memory; with one, records are written out whenever the buffer fills,
+// so memory stays at SPENT_BUFFER_RECORDS (or one transaction's inputs,
+// if it has more) however long the run is.
+typedef struct {
+    SpentOutput *records;   // not yet written to the file
+    int count;
+    int capacity;
+    FILE *file;
+    long written;           // records already in the file
+} SpentArchive;
+
+typedef void (*SpentVisitor)(const SpentOutput *spent, void *context);
+
+// 📦 Unspent output record for bulk loading (snapshot files store these)
+typedef struct {
+    Outpoint outpoint;
+    Amount amount;
+    int address_id;
+} SavedOutput;
+
+typedef struct UtxoCommitment UtxoCommitment;   // utxo_commit.h
+
+// Per-address index: the address's unspent outputs, oldest first, and the
+// same outputs sorted by amount (largest first) for coin selection.
+// Its position in UtxoSet.addresses is the address ID.
+typedef struct {
+    char address[MAX_ADDRESS_LEN];
+    int head;
+    int tail;
+    int unspent;
+    Amount balance;         // running sum, so no rescan is needed
+    int *by_amount;         // entry indices, `unspent` of them
+    int by_amount_capacity;
+} AddressIndex;
+
+// 💰 UTXO set
+//
+// The entry table holds the live (unspent) outputs only and stays dense: a
+// spent output is moved to the archive and the last entry takes its place,
+// and the tables shrink again when most of them are empty. It is stored as
+// a struct of arrays, one array per field indexed by entry, so sums over
+// all amounts read one contiguous array (SIMD reductions, see amount.h).
+// Outputs are found by outpoint through an open-addressing hash table, and
+// each address keeps a linked list of its unspent outputs, so lookups,
+// spends and balance queries never scan the whole history. Address strings
+// are interned once into dense IDs through a second hash table; everything
+// else refers to an address by its ID.
+typedef struct {
+    Outpoint *outpoints;
+    Amount *amounts;
+    int *address_ids;           // owner, interned in the address table
+    int *prev_by_address;       // neighbours in the owner's unspent list, -1 at the ends
+    int *next_by_address;
+    bool *locked;               // reserved by a pending transaction: hidden from its owner
+    int count;
+    int capacity;
+    Amount locked_total;        // sum of the locked amounts
+
+    int *outpoint_slots;        // entry index, -1 = empty
+    int outpoint_slot_count;    // power of two
+
+    AddressIndex *addresses;
+    int address_count;
+    int address_capacity;
+    int *address_slots;         // index into addresses, -1 = empty
+    int address_slot_count;     // power of two
+
+    SpentArchive spent;
+    UtxoCommitment *commitment; // NULL unless enabled
+} UtxoSet;
+
+// Bytes one entry takes across the field arrays
+#define UTXO_ENTRY_BYTES (sizeof(Outpoint) + sizeof(Amount) + 3 * sizeof(int) + sizeof(bool))
+
+void utxo_set_init(UtxoSet *set);
+void utxo_set_free(UtxoSet *set);
+
+// ID of `address`, adding it to the address table if needed (-1 if out of memory)
+int utxo_set_intern(UtxoSet *set, const char *address);
+
+// ID of `address`, or -1 if it was never interned
+int utxo_set_lookup(const UtxoSet *set, const char *address);
+
+// Add an unspent output owned by an interned address. Returns its entry
+// index, or -1 if out of memory.
+int utxo_set_add(UtxoSet *set, Outpoint outpoint, int address_id, Amount amount);
+
+// Make room for `count` new outputs, output i owned by address_ids[i], so
+// the next `count` utxo_set_add() calls for them cannot fail. Spends in
+// between keep the room: they only shrink tables that are far larger.
+// False if out of memory, with nothing added.
+bool utxo_set_reserve_outputs(UtxoSet *set, const int *address_ids, int count);
+
+// Add many outputs at once to a set that holds none yet (its addresses
+// already interned), e.g. from a snapshot. Give each address's outputs
+// oldest first: the tables are sized once and every amount list is sorted
+// once, instead of one sorted insert per output. If the commitment is
+// enabled, `commitment_state` (utxo_commitment_export) is imported as is;
+// pass NULL to fold the outputs in one by one. False on a bad address ID,
+// a repeated outpoint or out of memory; the set is then only partly loaded.
+bool utxo_set_load(UtxoSet *set, const SavedOutput *outputs, long count, const uint8_t *commitment_state);
+
+// Entry index of an unspent `outpoint`, or -1. Indices change when any
+// output is spent, so do not keep them across utxo_set_spend().
+int utxo_set_find(const UtxoSet *set, Outpoint outpoint);
+
+// Move an unspent output to the archive. False if it is not unspent, or
+// the archive cannot take it (out of memory or a failed write).
+bool utxo_set_spend(UtxoSet *set, Outpoint outpoint);
+
+// Make room in the archive for `count` spends, so the next `count`
+// utxo_set_spend() calls on unspent outputs cannot fail. Call it before
+// spending a transaction's inputs: it either fails with nothing spent, or
+// every input can be spent. False if out of memory or a write failed.
+bool utxo_set_reserve_spends(UtxoSet *set, int count);
+
+// Reserve an unspent output for a transaction that is not applied yet:
+// it stays in the set (utxo_set_find still sees it) but leaves its owner's
+// lists, balance and coin selection until it is spent or unlocked.
+bool utxo_set_lock(UtxoSet *set, Outpoint outpoint);
+bool utxo_set_unlock(UtxoSet *set, Outpoint outpoint);
+
+// Keep a rolling commitment (utxo_commit.h) to the live outputs, updated
+// by every add and spend. Enabling it on a non-empty set folds in the
+// outputs already there.
+bool utxo_set_enable_commitment(UtxoSet *set);
+
+// 32-byte digest of the live set; false if the commitment is not enabled
+bool utxo_set_commitment(UtxoSet *set, uint8_t digest[32]);
+
+// Commitment state of the live set (utxo_commitment_export), built from
+// scratch (O(n)) if the commitment is not enabled
+bool utxo_set_commitment_state(UtxoSet *set, uint8_t state[384]);
+
+// Rebuild the commitment from the live outputs (O(n)) and compare it with
+// the rolling one
+bool utxo_set_check_commitment(UtxoSet *set);
+
+// Write the spent archive to `path` (truncated) from now on
+bool utxo_set_archive_to(UtxoSet *set, const char *path);
+
+long utxo_set_spent_count(const UtxoSet *set);
+
+// Visit every spent output, oldest spend first, reading the archive file
+// back in chunks
+bool utxo_set_each_spent(UtxoSet *set, SpentVisitor visit, void *context);
+
+// Index of an interned address
+const AddressIndex *utxo_set_address(const UtxoSet *set, int address_id);
+
+// Oldest unspent entry of the address, or -1; continue with next_by_address
+int utxo_set_first(const UtxoSet *set, int address_id);
+
+Amount utxo_set_balance(const UtxoSet *set, int address_id);
+
+// Sum of every unspent amount (a SIMD reduction over the amount array)
+Amount utxo_set_total_supply(const UtxoSet *set);
+
+// Audit the running balances: every address's balance must equal the sum
+// of its unspent amounts, and the balances plus the locked amounts must
+// equal the total supply, which goes to *supply. O(n).
+bool utxo_set_audit(const UtxoSet *set, Amount *supply);
+
+// "TX12:1" <-> Outpoint
+bool parse_outpoint(const char *text, Outpoint *outpoint);
+void format_outpoint(Outpoint outpoint, char *out, int size);
+
+#endif
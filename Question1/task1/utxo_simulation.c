@@ -2,6 +2,14 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "utxo_set.h"
+#include "coin_select.h"
+#include "block_validate.h"
+#include "utxo_commit.h"
+#include "utxo_snapshot.h"
 
 // ANSI color codes for better CLI UI
 #define COLOR_GREEN "\033[1;32m"
@@ -10,71 +18,102 @@
 #define COLOR_CYAN "\033[1;36m"
 #define COLOR_RESET "\033[0m"
 
-#define MAX_ADDRESS_LEN 20
-#define MAX_UTXOS 100
-#define MAX_TXID_LEN 10
-#define MAX_USERS 50
-
-// UTXO structure
-typedef struct {
-    char txid[MAX_TXID_LEN];
-    char address[MAX_ADDRESS_LEN];
-    float amount;
-    bool spent;
-} UTXO;
+#define MAX_INPUTS 100
+#define INITIAL_FUNDING (60 * AMOUNT_SCALE)   // each user's first UTXO
 
 // User structure
 typedef struct {
     char name[MAX_ADDRESS_LEN];
-    char address[MAX_ADDRESS_LEN];
+    int address_id;         // interned in utxo_set
 } User;
 
 // Globals
-UTXO utxo_list[MAX_UTXOS];
-int utxo_count = 0;
-User user_list[MAX_USERS];
+UtxoSet utxo_set;
+uint32_t last_txid = 0;
+User *user_list = NULL;     // grows as users are added
 int user_count = 0;
+int user_capacity = 0;
+int *user_by_address = NULL;   // address ID -> index in user_list
+bool batch_mode = false;   // running a workload file: no menus or prompts
+CoinStrategy coin_strategy = SELECT_BNB;   // used when no UTXOs are chosen by hand
+int block_size = 0;        // batch mode: transactions per validated block, 0 = one at a time
+int validate_threads = 0;  // block validation workers, 0 = one per core
+bool restored = false;     // started from a snapshot: users already funded
+Amount funded_total = 0;   // value created by funding (or restored); transactions keep it constant
+const char *snapshot_path = NULL;   // batch mode: snapshot written here
+long snapshot_every = 0;   // batch mode: also every N transactions, 0 = at the end only
+long room_failures = 0;    // transactions rejected for lack of memory or a failed archive write
+SnapshotWriter snapshot_writer;
 
 // Generate address
 void generate_address(char *address, int index) {
     snprintf(address, MAX_ADDRESS_LEN, "ADDRESS%d", index + 1);
 }
 
-// Get user by address
-const char* get_user_name_by_address(const char *address) {
-    for (int i = 0; i < user_count; i++) {
-        if (strcmp(user_list[i].address, address) == 0) {
-            return user_list[i].name;
-        }
-    }
-    return "Unknown";
+// Amount as text for printf; four rotating buffers, so up to four per call
+const char *amount_text(Amount amount) {
+    static char buffers[4][32];
+    static int next = 0;
+    char *out = buffers[next++ % 4];
+    format_amount(amount, out, sizeof(buffers[0]));
+    return out;
 }
 
+const char *address_of(int address_id) {
+    return utxo_set_address(&utxo_set, address_id)->address;
+}
+
+// Every interned address belongs to a user, so a hash lookup is the check
 bool is_valid_address(const char *address) {
-    for (int i = 0; i < user_count; i++) {
-        if (strcmp(user_list[i].address, address) == 0) {
-            return true;
-        }
+    return utxo_set_lookup(&utxo_set, address) >= 0;
+}
+
+// Get user by address ID
+const char* get_user_name(int address_id) {
+    return user_list[user_by_address[address_id]].name;
+}
+
+// Add a user who owns an interned address
+bool add_user_record(int address_id, const char *name) {
+    if (user_count == user_capacity) {
+        int capacity = user_capacity ? user_capacity * 2 : 64;
+        User *users = realloc(user_list, sizeof(User) * capacity);
+        if (!users) return false;
+        user_list = users;
+        int *owners = realloc(user_by_address, sizeof(int) * capacity);
+        if (!owners) return false;
+        user_by_address = owners;
+        user_capacity = capacity;
     }
-    return false;
+
+    // IDs are dense and only users intern addresses, so address_id < user_capacity
+    snprintf(user_list[user_count].name, MAX_ADDRESS_LEN, "%s", name);
+    user_list[user_count].address_id = address_id;
+    user_by_address[address_id] = user_count;
+    user_count++;
+    return true;
+}
+
+// Create a user with the next free address
+bool create_user(const char *name) {
+    char address[MAX_ADDRESS_LEN];
+    generate_address(address, user_count);
+    int id = utxo_set_intern(&utxo_set, address);
+    return id >= 0 && add_user_record(id, name);
 }
 
 // Add user interactively
 void add_user() {
-    if (user_count >= MAX_USERS) {
-        printf(COLOR_RED "User limit reached.\n" COLOR_RESET);
-        return;
-    }
-
     char name[MAX_ADDRESS_LEN];
     printf(COLOR_YELLOW "Enter new user name: " COLOR_RESET);
-    scanf("%s", name);
+    scanf("%19s", name);
 
-    strcpy(user_list[user_count].name, name);
-    generate_address(user_list[user_count].address, user_count);
+    if (!create_user(name)) {
+        printf(COLOR_RED "Out of memory.\n" COLOR_RESET);
+        return;
+    }
     printf(COLOR_GREEN "✅ User '%s' created with address '%s'\n" COLOR_RESET,
-           name, user_list[user_count].address);
-    user_count++;
+           name, address_of(user_list[user_count - 1].address_id));
 }
 
 // Show all users
@@ -83,67 +122,177 @@ void display_users() {
     printf("Name               | Address\n");
     printf("------------------------------\n");
     for (int i = 0; i < user_count; i++) {
-        printf("%-18s | %s\n", user_list[i].name, user_list[i].address);
+        printf("%-18s | %s\n", user_list[i].name, address_of(user_list[i].address_id));
     }
 }
 
-// Show unspent UTXOs
+// Show unspent UTXOs, user by user (per-address index, no history scan)
 void display_utxos() {
     printf(COLOR_CYAN "\n=== 💰 Unspent UTXOs ===\n" COLOR_RESET);
-    printf("Index | TXID  | User (Address)         | Amount  \n");
+    printf("Outpoint   | User (Address)         | Amount  \n");
     printf("------------------------------------------------\n");
-    for (int i = 0; i < utxo_count; i++) {
-        if (!utxo_list[i].spent) {
-            printf("%-5d | %-5s | %-18s (%s) | %.2f\n", i, utxo_list[i].txid,
-                   get_user_name_by_address(utxo_list[i].address),
-                   utxo_list[i].address, utxo_list[i].amount);
+    for (int u = 0; u < user_count; u++) {
+        int id = user_list[u].address_id;
+        for (int i = utxo_set_first(&utxo_set, id); i != -1; i = utxo_set.next_by_address[i]) {
+            char outpoint[24];
+            format_outpoint(utxo_set.outpoints[i], outpoint, sizeof(outpoint));
+            printf("%-10s | %-18s (%s) | %s\n", outpoint, user_list[u].name,
+                   address_of(id), amount_text(utxo_set.amounts[i]));
         }
     }
 }
 
-// Show all UTXOs
+static void print_utxo_row(Outpoint outpoint, int address_id, Amount amount, bool spent) {
+    char text[24];
+    format_outpoint(outpoint, text, sizeof(text));
+    printf("%-10s | %-18s (%s) | %s | %s\n", text, get_user_name(address_id),
+           address_of(address_id), amount_text(amount), spent ? "Yes" : "No");
+}
+
+static void print_spent_row(const SpentOutput *spent, void *context) {
+    (void)context;
+    print_utxo_row(spent->outpoint, spent->address_id, spent->amount, true);
+}
+
+// Show all UTXOs: the spent archive (streamed, in spend order), then the live set
 void display_all_utxos() {
     printf(COLOR_CYAN "\n=== 📦 All UTXOs ===\n" COLOR_RESET);
-    printf("Index | TXID  | User (Address)         | Amount  | Spent\n");
+    printf("Outpoint   | User (Address)         | Amount  | Spent\n");
     printf("----------------------------------------------------------\n");
-    for (int i = 0; i < utxo_count; i++) {
-        printf("%-5d | %-5s | %-18s (%s) | %.2f | %s\n", i, utxo_list[i].txid,
-               get_user_name_by_address(utxo_list[i].address),
-               utxo_list[i].address, utxo_list[i].amount,
-               utxo_list[i].spent ? "Yes" : "No");
+    if (!utxo_set_each_spent(&utxo_set, print_spent_row, NULL)) {
+        printf(COLOR_RED "Could not read the spent archive.\n" COLOR_RESET);
+    }
+    for (int i = 0; i < utxo_set.count; i++) {
+        print_utxo_row(utxo_set.outpoints[i], utxo_set.address_ids[i], utxo_set.amounts[i], false);
     }
 }
 
-void generate_txid(char *txid) {
-    static int counter = 1;
-    snprintf(txid, MAX_TXID_LEN, "TX%d", counter++);
+uint32_t generate_txid() {
+    return ++last_txid;
 }
 
-void initialize_user_utxos(float amount_per_user) {
+void initialize_user_utxos(Amount amount_per_user) {
+    int unfunded = 0;
     for (int i = 0; i < user_count; i++) {
-        char txid[MAX_TXID_LEN];
-        generate_txid(txid);
-        strcpy(utxo_list[utxo_count].txid, txid);
-        strcpy(utxo_list[utxo_count].address, user_list[i].address);
-        utxo_list[utxo_count].amount = amount_per_user;
-        utxo_list[utxo_count].spent = false;
-        utxo_count++;
+        Outpoint outpoint = { generate_txid(), 0 };
+        if (utxo_set_add(&utxo_set, outpoint, user_list[i].address_id, amount_per_user) < 0) {
+            unfunded++;
+            continue;
+        }
+        funded_total += amount_per_user;
+    }
+    if (unfunded > 0) {
+        printf(COLOR_RED "Out of memory: %d user(s) were not funded.\n" COLOR_RESET, unfunded);
+    }
+    if (!batch_mode) {
+        printf(COLOR_GREEN "✅ Each user initialized with %s UTXO.\n" COLOR_RESET, amount_text(amount_per_user));
     }
-    printf(COLOR_GREEN "✅ Each user initialized with %.2f UTXO.\n" COLOR_RESET, amount_per_user);
+}
+
+// Report a rejected transaction (quietly in batch mode)
+static bool reject(const char *reason) {
+    if (!batch_mode) {
+        printf(COLOR_RED "%s\n" COLOR_RESET, reason);
+    }
+    return false;
+}
+
+// Spend the `selected` outpoints of `sender` to pay `amount` to `receiver`.
+// With sel_count == 0 the coin selection engine picks the inputs using
+// `coin_strategy`. The payment is output 0 of the new transaction and any
+// change output 1. Nothing changes unless the whole transaction is valid.
+bool submit_transaction(const char *sender, const char *receiver, Amount amount,
+                        const Outpoint *selected, int sel_count) {
+    int from = utxo_set_lookup(&utxo_set, sender);
+    int to = utxo_set_lookup(&utxo_set, receiver);
+    if (from < 0) return reject("Invalid sender address.");
+    if (to < 0) return reject("Invalid receiver address.");
+    if (from == to) return reject("Sender and receiver must be different.");
+    if (amount <= 0) return reject("Amount must be positive.");
+
+    int picked[MAX_INPUTS];
+    Amount collected = 0;
+    CoinSelection selection = {0};
+    const Outpoint *inputs = selected;
+    int input_count = sel_count;
+    if (sel_count == 0) {
+        if (!select_coins(&utxo_set, from, amount, coin_strategy, &selection)) {
+            if (!batch_mode) {
+                printf(COLOR_RED "Insufficient funds. Available: %s\n" COLOR_RESET,
+                       amount_text(utxo_set_balance(&utxo_set, from)));
+            }
+            coin_selection_free(&selection);
+            return false;
+        }
+        collected = selection.total;
+        inputs = selection.inputs;
+        input_count = selection.count;
+    } else {
+        for (int i = 0; i < sel_count; i++) {
+            int idx = utxo_set_find(&utxo_set, selected[i]);
+            if (idx < 0 || utxo_set.address_ids[idx] != from) {
+                return reject("Invalid UTXO.");
+            }
+            for (int j = 0; j < i; j++) {
+                if (picked[j] == idx) return reject("UTXO selected twice.");
+            }
+            collected += utxo_set.amounts[idx];
+            picked[i] = idx;
+        }
+        if (collected < amount) {
+            if (!batch_mode) {
+                printf(COLOR_RED "Selected UTXOs (%s) do not cover %s\n" COLOR_RESET,
+                       amount_text(collected), amount_text(amount));
+            }
+            return false;
+        }
+    }
+
+    // All or nothing: room for every spend and every new output is made
+    // before anything changes, so neither can fail halfway
+    Amount change = collected - amount;
+    int owners[2] = { to, from };
+    bool ready = utxo_set_reserve_spends(&utxo_set, input_count) &&
+                 utxo_set_reserve_outputs(&utxo_set, owners, change > 0 ? 2 : 1);
+    for (int i = 0; ready && i < input_count; i++) {
+        ready = utxo_set_spend(&utxo_set, inputs[i]);
+    }
+    coin_selection_free(&selection);
+    if (!ready) {
+        room_failures++;
+        return reject("Could not record the transaction (out of memory or a failed write).");
+    }
+
+    uint32_t txid = generate_txid();
+    Outpoint payment = { txid, 0 };
+    utxo_set_add(&utxo_set, payment, to, amount);
+
+    if (change > 0) {
+        Outpoint back = { txid, 1 };
+        utxo_set_add(&utxo_set, back, from, change);
+    }
+
+    if (!batch_mode) {
+        printf(COLOR_GREEN "\n✅ Transaction Complete!\n" COLOR_RESET);
+        printf("Sender: %s → Receiver: %s | Amount: %s | Change: %s\n",
+               get_user_name(from), get_user_name(to), amount_text(amount), amount_text(change));
+    }
+    return true;
 }
 
 // Transaction process
 void perform_transaction() {
-    char sender[MAX_ADDRESS_LEN], receiver[MAX_ADDRESS_LEN];
-    float amount;
+    char sender[MAX_ADDRESS_LEN], receiver[MAX_ADDRESS_LEN], amount_input[32];
+    Amount amount;
 
     display_users();
-    printf(COLOR_YELLOW "Enter sender's address: " COLOR_RESET); scanf("%s", sender);
-    if (!is_valid_address(sender)) {
+    printf(COLOR_YELLOW "Enter sender's address: " COLOR_RESET); scanf("%19s", sender);
+    int from = utxo_set_lookup(&utxo_set, sender);
+    if (from < 0) {
         printf(COLOR_RED "Invalid sender address.\n" COLOR_RESET); return;
     }
 
-    printf(COLOR_YELLOW "Enter receiver's address: " COLOR_RESET); scanf("%s", receiver);
+    printf(COLOR_YELLOW "Enter receiver's address: " COLOR_RESET); scanf("%19s", receiver);
     if (!is_valid_address(receiver)) {
         printf(COLOR_RED "Invalid receiver address.\n" COLOR_RESET); return;
     }
@@ -153,103 +302,487 @@ void perform_transaction() {
         return;
     }
 
-    printf(COLOR_YELLOW "Enter amount to send: " COLOR_RESET); scanf("%f", &amount);
+    printf(COLOR_YELLOW "Enter amount to send: " COLOR_RESET); scanf("%31s", amount_input);
+    if (!parse_amount(amount_input, &amount)) {
+        printf(COLOR_RED "Invalid amount (at most two decimals).\n" COLOR_RESET); return;
+    }
     if (amount <= 0) {
         printf(COLOR_RED "Amount must be positive.\n" COLOR_RESET); return;
     }
 
     // Display sender's UTXOs
-    float total = 0.0;
-    int selected[MAX_UTXOS], sel_count = 0;
     printf(COLOR_CYAN "\nAvailable UTXOs for sender:\n" COLOR_RESET);
-    for (int i = 0; i < utxo_count; i++) {
-        if (!utxo_list[i].spent && strcmp(utxo_list[i].address, sender) == 0) {
-            printf("[%d] TXID: %s - %.2f\n", i, utxo_list[i].txid, utxo_list[i].amount);
-            total += utxo_list[i].amount;
-        }
+    for (int i = utxo_set_first(&utxo_set, from); i != -1; i = utxo_set.next_by_address[i]) {
+        char outpoint[24];
+        format_outpoint(utxo_set.outpoints[i], outpoint, sizeof(outpoint));
+        printf("[%s] %s\n", outpoint, amount_text(utxo_set.amounts[i]));
     }
 
+    Amount total = utxo_set_balance(&utxo_set, from);
     if (total < amount) {
-        printf(COLOR_RED "Insufficient funds. Available: %.2f\n" COLOR_RESET, total);
+        printf(COLOR_RED "Insufficient funds. Available: %s\n" COLOR_RESET, amount_text(total));
         return;
     }
 
-    printf(COLOR_YELLOW "\nSelect UTXOs by index to spend (-1 to stop):\n" COLOR_RESET);
-    float collected = 0.0;
-    while (collected < amount) {
-        int idx;
-        printf("Enter UTXO index: "); scanf("%d", &idx);
-        if (idx == -1) break;
-        if (idx < 0 || idx >= utxo_count || utxo_list[idx].spent ||
-            strcmp(utxo_list[idx].address, sender) != 0) {
+    printf(COLOR_YELLOW "\nSelect UTXOs to spend, e.g. TX3:0 (-1 to stop, auto to let %s coin selection pick):\n" COLOR_RESET,
+           coin_strategy_name(coin_strategy));
+    Outpoint selected[MAX_INPUTS];
+    int sel_count = 0;
+    Amount collected = 0;
+    while (collected < amount && sel_count < MAX_INPUTS) {
+        char text[24];
+        Outpoint outpoint;
+        printf("Enter UTXO: "); scanf("%23s", text);
+        if (strcmp(text, "-1") == 0) break;
+        if (strcmp(text, "auto") == 0 && sel_count == 0) {
+            submit_transaction(sender, receiver, amount, NULL, 0);
+            return;
+        }
+        int idx = parse_outpoint(text, &outpoint) ? utxo_set_find(&utxo_set, outpoint) : -1;
+        if (idx < 0 || utxo_set.address_ids[idx] != from) {
             printf(COLOR_RED "Invalid UTXO.\n" COLOR_RESET); continue;
         }
 
-        collected += utxo_list[idx].amount;
-        selected[sel_count++] = idx;
+        collected += utxo_set.amounts[idx];
+        selected[sel_count++] = outpoint;
     }
 
     if (collected < amount) {
-        printf(COLOR_RED "Selected UTXOs (%.2f) do not cover %.2f\n" COLOR_RESET, collected, amount);
+        printf(COLOR_RED "Selected UTXOs (%s) do not cover %s\n" COLOR_RESET,
+               amount_text(collected), amount_text(amount));
         return;
     }
 
-    for (int i = 0; i < sel_count; i++) {
-        utxo_list[selected[i]].spent = true;
+    submit_transaction(sender, receiver, amount, selected, sel_count);
+}
+
+// Batch mode: latency samples in seconds
+typedef struct {
+    double *samples;
+    int count;
+    int capacity;
+} LatencyLog;
+
+static double now_seconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void record_latency(LatencyLog *log, double seconds) {
+    if (log->count == log->capacity) {
+        int capacity = log->capacity ? log->capacity * 2 : 1024;
+        double *grown = realloc(log->samples, sizeof(double) * capacity);
+        if (!grown) return;
+        log->samples = grown;
+        log->capacity = capacity;
     }
+    log->samples[log->count++] = seconds;
+}
 
-    char txid1[MAX_TXID_LEN], txid2[MAX_TXID_LEN];
-    generate_txid(txid1);
-    strcpy(utxo_list[utxo_count].txid, txid1);
-    strcpy(utxo_list[utxo_count].address, receiver);
-    utxo_list[utxo_count].amount = amount;
-    utxo_list[utxo_count].spent = false;
-    utxo_count++;
+static int compare_doubles(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
 
-    float change = collected - amount;
-    if (change > 0) {
-        generate_txid(txid2);
-        strcpy(utxo_list[utxo_count].txid, txid2);
-        strcpy(utxo_list[utxo_count].address, sender);
-        utxo_list[utxo_count].amount = change;
-        utxo_list[utxo_count].spent = false;
-        utxo_count++;
+static double percentile(const double *sorted, int n, double p) {
+    return sorted[(int)(p / 100.0 * (n - 1) + 0.5)];
+}
+
+// Print the rolling UTXO-set commitment and check it against a rebuild
+static void print_commitment(const char *label) {
+    uint8_t digest[COMMITMENT_LEN];
+    char hex[2 * COMMITMENT_LEN + 1];
+    if (!utxo_set_commitment(&utxo_set, digest)) {
+        printf("%sunavailable\n", label);
+        return;
+    }
+    format_commitment(digest, hex, sizeof(hex));
+    bool match = utxo_set_check_commitment(&utxo_set);
+    printf("%s%s %s\n", label, hex, match ? "(matches a full rebuild)" : COLOR_RED "(MISMATCH)" COLOR_RESET);
+}
+
+// 📸 Start writing a snapshot in the background
+static bool start_snapshot(const char *path) {
+    return utxo_snapshot_start(&snapshot_writer, path, &utxo_set, last_txid, get_user_name);
+}
+
+// Report a background snapshot that has finished (interactive mode)
+static void report_snapshot(bool wait) {
+    int done = utxo_snapshot_collect(&snapshot_writer, wait);
+    if (done > 0) printf(COLOR_GREEN "\n📸 Snapshot saved.\n" COLOR_RESET);
+    if (done < 0) printf(COLOR_RED "\nSnapshot could not be written.\n" COLOR_RESET);
+}
+
+// Save a snapshot from the menu; the menu stays usable while it is written
+void save_snapshot() {
+    char path[256];
+    printf(COLOR_YELLOW "Snapshot file: " COLOR_RESET);
+    scanf("%255s", path);
+    if (start_snapshot(path)) {
+        printf(COLOR_GREEN "📸 Writing snapshot to %s in the background...\n" COLOR_RESET, path);
+    } else {
+        printf(COLOR_RED "A snapshot is still being written, try again shortly.\n" COLOR_RESET);
+    }
+}
+
+// Load users and UTXOs from a snapshot instead of creating and funding them
+static bool restore_snapshot(const char *path) {
+    double start = now_seconds();
+    if (!utxo_snapshot_restore(path, &utxo_set, &last_txid, add_user_record)) return false;
+    printf(COLOR_GREEN "📂 Restored %d users and %d UTXOs from %s in %.2f ms\n" COLOR_RESET,
+           user_count, utxo_set.count, path, (now_seconds() - start) * 1e3);
+    restored = true;
+    funded_total = utxo_set_total_supply(&utxo_set);
+    return true;
+}
+
+// 🧱 Block mode: transactions wait here until the block is full
+typedef struct {
+    BlockTx *txs;
+    int count;
+    int capacity;
+} BlockQueue;
+
+static bool queue_tx(BlockQueue *queue, const char *sender, const char *receiver, Amount amount,
+                     const Outpoint *selected, int sel_count) {
+    if (queue->count == queue->capacity) {
+        int capacity = queue->capacity ? queue->capacity * 2 : 256;
+        BlockTx *grown = realloc(queue->txs, sizeof(BlockTx) * capacity);
+        if (!grown) return false;
+        queue->txs = grown;
+        queue->capacity = capacity;
+    }
+    BlockTx *tx = &queue->txs[queue->count];
+    snprintf(tx->sender, MAX_ADDRESS_LEN, "%s", sender);
+    snprintf(tx->receiver, MAX_ADDRESS_LEN, "%s", receiver);
+    tx->amount = amount;
+    tx->inputs = NULL;
+    tx->input_count = sel_count;
+    tx->picked = false;
+    if (sel_count > 0) {
+        tx->inputs = malloc(sizeof(Outpoint) * sel_count);
+        if (!tx->inputs) return false;
+        memcpy(tx->inputs, selected, sizeof(Outpoint) * sel_count);
+    }
+    queue->count++;
+    return true;
+}
+
+typedef struct {
+    long blocks;
+    long accepted;
+    long rejected;
+    double validate_seconds;
+} BlockTotals;
+
+// Pick coins for the queued transactions that name no inputs, validate
+// the block in parallel and apply it. Coins picked for one transaction are
+// locked so later ones in the block pick different coins. A transaction
+// that could not be covered here picks again when the block is applied,
+// where it can use outputs created earlier in the block.
+static void process_block(BlockQueue *queue, BlockTotals *totals, LatencyLog *latency) {
+    if (queue->count == 0) return;
+    double start = now_seconds();
+    for (int i = 0; i < queue->count; i++) {
+        BlockTx *tx = &queue->txs[i];
+        int from = utxo_set_lookup(&utxo_set, tx->sender);
+        if (tx->input_count > 0 || from < 0 || tx->amount <= 0) continue;
+
+        CoinSelection selection = {0};
+        if (select_coins(&utxo_set, from, tx->amount, coin_strategy, &selection)) {
+            tx->inputs = selection.inputs;
+            tx->input_count = selection.count;
+            tx->picked = true;
+            for (int k = 0; k < tx->input_count; k++) utxo_set_lock(&utxo_set, tx->inputs[k]);
+        } else {
+            coin_selection_free(&selection);    // no inputs: deferred to apply_block
+        }
+    }
+
+    double t0 = now_seconds();
+    validate_block(&utxo_set, queue->txs, queue->count, validate_threads);
+    totals->validate_seconds += now_seconds() - t0;
+    int applied = apply_block(&utxo_set, queue->txs, queue->count, coin_strategy, &last_txid);
+
+    totals->blocks++;
+    totals->accepted += applied;
+    totals->rejected += queue->count - applied;
+    for (int i = 0; i < queue->count; i++) {
+        if (queue->txs[i].status == TX_NO_ROOM) room_failures++;
+        free(queue->txs[i].inputs);
+    }
+    queue->count = 0;
+    record_latency(latency, now_seconds() - start);
+}
+
+// Batch mode: a background snapshot every `snapshot_every` transactions,
+// taken between transactions (or blocks), never in the middle of one
+static void periodic_snapshot(long processed, long *next) {
+    if (!snapshot_path || snapshot_every <= 0 || processed < *next) return;
+    start_snapshot(snapshot_path);
+    while (*next <= processed) *next += snapshot_every;
+}
+
+// Run a workload file without menus, one command per line:
+//   user <name>                          create a user; users listed before
+//                                        the first transaction get 60 units
+//   tx <from> <to> <amount> [TXn:v...]   addresses, optional outpoints to
+//                                        spend (default: coin selection)
+//   block ...                            ends the current block in block
+//                                        mode, otherwise ignored
+// Lines starting with '#' are comments. With block_size > 0 transactions
+// are validated and applied block by block instead of one at a time.
+bool run_batch(const char *path) {
+    FILE *in = fopen(path, "r");
+    if (!in) {
+        printf(COLOR_RED "Cannot open workload %s\n" COLOR_RESET, path);
+        return false;
     }
 
-    printf(COLOR_GREEN "\n✅ Transaction Complete!\n" COLOR_RESET);
-    printf("Sender: %s → Receiver: %s | Amount: %.2f | Change: %.2f\n",
-           get_user_name_by_address(sender), get_user_name_by_address(receiver), amount, change);
+    long lines = 0, skipped = 0, users = 0, accepted = 0, rejected = 0;
+    long next_snapshot = snapshot_every;
+    bool funded = restored;
+    LatencyLog latency = {0};
+    BlockQueue queue = {0};
+    BlockTotals totals = {0};
+    char line[4096];
+
+    batch_mode = true;
+    printf(COLOR_CYAN "📥 Running workload %s...\n" COLOR_RESET, path);
+    double start = now_seconds();
+
+    while (fgets(line, sizeof(line), in)) {
+        lines++;
+        char command[16];
+        int consumed = 0;
+        if (sscanf(line, "%15s %n", command, &consumed) < 1 || command[0] == '#') continue;
+
+        if (strcmp(command, "user") == 0) {
+            char name[MAX_ADDRESS_LEN];
+            if (sscanf(line + consumed, "%19s", name) == 1 && create_user(name)) users++;
+            else skipped++;
+            continue;
+        }
+        if (strcmp(command, "block") == 0) {
+            if (block_size > 0) process_block(&queue, &totals, &latency);
+            continue;
+        }
+        if (strcmp(command, "tx") != 0) {
+            skipped++;
+            continue;
+        }
+
+        // The initial users are funded once, like the interactive start-up
+        if (!funded) {
+            initialize_user_utxos(INITIAL_FUNDING);
+            funded = true;
+        }
+
+        char sender[MAX_ADDRESS_LEN], receiver[MAX_ADDRESS_LEN], amount_input[32];
+        Amount amount;
+        int n = 0;
+        if (sscanf(line + consumed, "%19s %19s %31s %n", sender, receiver, amount_input, &n) < 3 ||
+            !parse_amount(amount_input, &amount)) {
+            skipped++;
+            continue;
+        }
+        Outpoint selected[MAX_INPUTS];
+        int sel_count = 0;
+        const char *p = line + consumed + n;
+        char text[24];
+        int used;
+        bool bad_input = false;
+        while (sel_count < MAX_INPUTS && sscanf(p, "%23s%n", text, &used) == 1) {
+            if (text[0] == '#') break;      // trailing comment
+            bad_input |= !parse_outpoint(text, &selected[sel_count++]);
+            p += used;
+        }
+        if (bad_input) {
+            skipped++;
+            continue;
+        }
+
+        if (block_size > 0) {
+            if (!queue_tx(&queue, sender, receiver, amount, selected, sel_count)) {
+                skipped++;
+                continue;
+            }
+            if (queue.count >= block_size) {
+                process_block(&queue, &totals, &latency);
+                periodic_snapshot(totals.accepted + totals.rejected, &next_snapshot);
+            }
+            continue;
+        }
+
+        double t0 = now_seconds();
+        if (submit_transaction(sender, receiver, amount, selected, sel_count)) accepted++;
+        else rejected++;
+        record_latency(&latency, now_seconds() - t0);
+        periodic_snapshot(accepted + rejected, &next_snapshot);
+    }
+    if (!funded) initialize_user_utxos(INITIAL_FUNDING);
+    process_block(&queue, &totals, &latency);
+    free(queue.txs);
+    accepted += totals.accepted;
+    rejected += totals.rejected;
+
+    double elapsed = now_seconds() - start;
+
+    // Final snapshot of the end state, after any still being written
+    if (snapshot_path) {
+        utxo_snapshot_collect(&snapshot_writer, true);
+        start_snapshot(snapshot_path);
+        utxo_snapshot_collect(&snapshot_writer, true);
+    }
+    batch_mode = false;
+    fclose(in);
+
+    printf(COLOR_CYAN "\n=== 📊 Batch Summary ===\n" COLOR_RESET);
+    printf("Lines read     : %ld (%ld skipped)\n", lines, skipped);
+    printf("Users created  : %ld\n", users);
+    printf("Transactions   : %ld accepted, %ld rejected\n", accepted, rejected);
+    if (room_failures > 0) {
+        printf(COLOR_RED "No room        : %ld transaction(s) rejected, out of memory or a failed write\n" COLOR_RESET,
+               room_failures);
+    }
+    printf("Coin selection : %s\n", coin_strategy_name(coin_strategy));
+    if (block_size > 0) {
+        printf("Blocks         : %ld (up to %d tx), validated on %d thread(s)\n",
+               totals.blocks, block_size, validate_threads);
+        if (totals.validate_seconds > 0) {
+            printf("Validation     : %.1f tx/s\n", (accepted + rejected) / totals.validate_seconds);
+        }
+    }
+    print_commitment("Commitment     : ");
+
+    // Transactions move value, never create it: the supply is what was funded
+    Amount supply;
+    double audit_start = now_seconds();
+    bool audited = utxo_set_audit(&utxo_set, &supply);
+    double audit_ms = (now_seconds() - audit_start) * 1e3;
+    printf("Total supply   : %s, balances %s (%.2f ms)\n", amount_text(supply),
+           audited ? "add up" : COLOR_RED "DO NOT ADD UP" COLOR_RESET, audit_ms);
+    if (supply != funded_total) {
+        printf(COLOR_RED "Supply differs from the %s funded\n" COLOR_RESET, amount_text(funded_total));
+    }
+    printf("Outputs        : %d unspent, %ld spent%s\n", utxo_set.count, utxo_set_spent_count(&utxo_set),
+           utxo_set.spent.file ? " (archived to disk)" : "");
+    if (snapshot_path) {
+        printf("Snapshots      : %ld written to %s, %ld failed, %ld skipped (previous still writing)\n",
+               snapshot_writer.written, snapshot_path, snapshot_writer.failed, snapshot_writer.skipped);
+        if (snapshot_writer.forks > 0) {
+            printf("Snapshot pause : %.1f us per fork\n", snapshot_writer.fork_seconds / snapshot_writer.forks * 1e6);
+        }
+    }
+    printf("Live set       : %.1f KB\n", (utxo_set.capacity * UTXO_ENTRY_BYTES +
+                                          utxo_set.outpoint_slot_count * sizeof(int)) / 1024.0);
+    printf("Wall time      : %.3f s\n", elapsed);
+    if (elapsed > 0) printf("Throughput     : %.1f tx/s\n", (accepted + rejected) / elapsed);
+    if (latency.count > 0) {
+        qsort(latency.samples, latency.count, sizeof(double), compare_doubles);
+        printf("%s: p50 %.2f us, p90 %.2f us, p99 %.2f us, max %.2f us\n",
+               block_size > 0 ? "Block latency  " : "Tx latency     ",
+               percentile(latency.samples, latency.count, 50) * 1e6,
+               percentile(latency.samples, latency.count, 90) * 1e6,
+               percentile(latency.samples, latency.count, 99) * 1e6,
+               latency.samples[latency.count - 1] * 1e6);
+    }
+    free(latency.samples);
+    return true;
 }
 
 // Main Menu
-int main() {
+int main(int argc, char *argv[]) {
     printf(COLOR_GREEN "=====================================\n" COLOR_RESET);
     printf(COLOR_GREEN "   💸 UTXO Blockchain Simulator      \n" COLOR_RESET);
     printf(COLOR_GREEN "=====================================\n" COLOR_RESET);
 
-    // Create users at runtime
-    int initial_users;
-    printf(COLOR_YELLOW "How many users to create? " COLOR_RESET);
-    scanf("%d", &initial_users);
-    for (int i = 0; i < initial_users; i++) {
-        printf("Enter name for user %d: ", i + 1);
-        char name[MAX_ADDRESS_LEN];
-        scanf("%s", name);
-        strcpy(user_list[user_count].name, name);
-        generate_address(user_list[user_count].address, user_count);
-        user_count++;
+    // Non-interactive run: ./utxo_simulation --batch workload.txt [--coin-select bnb]
+    // --archive spent.bin keeps spent outputs on disk instead of in memory
+    // --restore snap.bin starts from a snapshot, --snapshot snap.bin saves one
+    const char *batch_path = NULL;
+    const char *restore_path = NULL;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        bool ok = true;
+        if (strcmp(argv[i], "--batch") == 0) {
+            batch_path = argv[i + 1];
+        } else if (strcmp(argv[i], "--coin-select") == 0) {
+            ok = parse_coin_strategy(argv[i + 1], &coin_strategy);
+        } else if (strcmp(argv[i], "--block") == 0) {
+            block_size = atoi(argv[i + 1]);
+            ok = block_size > 0;
+        } else if (strcmp(argv[i], "--threads") == 0) {
+            validate_threads = atoi(argv[i + 1]);
+            ok = validate_threads > 0;
+        } else if (strcmp(argv[i], "--restore") == 0) {
+            restore_path = argv[i + 1];
+        } else if (strcmp(argv[i], "--snapshot") == 0) {
+            snapshot_path = argv[i + 1];
+        } else if (strcmp(argv[i], "--snapshot-every") == 0) {
+            snapshot_every = atol(argv[i + 1]);
+            ok = snapshot_every > 0;
+        } else if (strcmp(argv[i], "--archive") == 0) {
+            ok = utxo_set_archive_to(&utxo_set, argv[i + 1]);
+            if (!ok) printf(COLOR_RED "Cannot create archive %s\n" COLOR_RESET, argv[i + 1]);
+        } else {
+            ok = false;
+        }
+        if (!ok) {
+            printf(COLOR_RED "Usage: %s [--batch file] [--coin-select oldest|largest|bnb|knapsack] [--archive file]\n"
+                   "          [--block N] [--threads N] [--restore file] [--snapshot file [--snapshot-every N]]\n"
+                   COLOR_RESET, argv[0]);
+            return 1;
+        }
+    }
+    if (!utxo_set_enable_commitment(&utxo_set)) {
+        printf(COLOR_RED "Cannot set up the UTXO commitment\n" COLOR_RESET);
+        return 1;
+    }
+    if (restore_path && !restore_snapshot(restore_path)) {
+        utxo_set_free(&utxo_set);
+        free(user_list);
+        free(user_by_address);
+        return 1;
+    }
+    if (validate_threads == 0) {
+        long cores = sysconf(_SC_NPROCESSORS_ONLN);
+        validate_threads = cores > 0 ? (int)cores : 1;
+    }
+    if (batch_path) {
+        bool ok = run_batch(batch_path);
+        utxo_set_free(&utxo_set);
+        free(user_list);
+        free(user_by_address);
+        return ok ? 0 : 1;
     }
 
-    initialize_user_utxos(60.0);
+    // Create users at runtime (unless they came from a snapshot)
+    if (!restored) {
+        int initial_users;
+        printf(COLOR_YELLOW "How many users to create? " COLOR_RESET);
+        scanf("%d", &initial_users);
+        for (int i = 0; i < initial_users; i++) {
+            printf("Enter name for user %d: ", i + 1);
+            char name[MAX_ADDRESS_LEN];
+            scanf("%19s", name);
+            create_user(name);
+        }
+
+        initialize_user_utxos(INITIAL_FUNDING);
+    }
 
     while (1) {
+        report_snapshot(false);
         printf(COLOR_CYAN "\n===== 📋 Main Menu =====\n" COLOR_RESET);
         printf("1. View Unspent UTXOs\n");
         printf("2. View All UTXOs\n");
         printf("3. View Users\n");
         printf("4. Perform Transaction\n");
         printf("5. Add New User\n");
-        printf("6. Exit\n");
+        printf("6. Show UTXO Set Commitment\n");
+        printf("7. Save Snapshot\n");
+        printf("8. Exit\n");
         printf(COLOR_YELLOW "Select option: " COLOR_RESET);
         int choice;
         scanf("%d", &choice);
@@ -260,8 +793,14 @@ int main() {
             case 3: display_users(); break;
             case 4: perform_transaction(); break;
             case 5: add_user(); break;
-            case 6:
+            case 6: print_commitment("🔏 Commitment: "); break;
+            case 7: save_snapshot(); break;
+            case 8:
+                report_snapshot(true);
                 printf(COLOR_GREEN "Goodbye!\n" COLOR_RESET);
+                utxo_set_free(&utxo_set);
+                free(user_list);
+                free(user_by_address);
                 return 0;
             default:
                 printf(COLOR_RED "Invalid choice.\n" COLOR_RESET);
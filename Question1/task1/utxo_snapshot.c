@@ -0,0 +1,233 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <openssl/evp.h>
+#include <openssl/sha.h>
+
+#include "utxo_snapshot.h"
+
+#define SNAPSHOT_CHUNK 4096     // output records buffered per write
+
+// Write `size` bytes and add them to the running checksum
+static bool write_hashed(FILE *out, EVP_MD_CTX *sha, const void *data, size_t size) {
+    return fwrite(data, 1, size, out) == size && EVP_DigestUpdate(sha, data, size);
+}
+
+// Output records on their way to the file
+typedef struct {
+    FILE *out;
+    EVP_MD_CTX *sha;
+    SavedOutput records[SNAPSHOT_CHUNK];
+    int count;
+    long saved;
+    bool ok;
+} OutputBuffer;
+
+static void save_output(OutputBuffer *buffer, const UtxoSet *set, int index) {
+    SavedOutput *record = &buffer->records[buffer->count++];
+    memset(record, 0, sizeof(*record));     // padding goes into the file and checksum
+    record->outpoint = set->outpoints[index];
+    record->amount = set->amounts[index];
+    record->address_id = set->address_ids[index];
+    buffer->saved++;
+    if (buffer->count == SNAPSHOT_CHUNK) {
+        buffer->ok = buffer->ok && write_hashed(buffer->out, buffer->sha, buffer->records,
+                                                sizeof(SavedOutput) * buffer->count);
+        buffer->count = 0;
+    }
+}
+
+static bool write_body(FILE *out, EVP_MD_CTX *sha, UtxoSet *set, SnapshotOwnerName owner_name,
+                       const uint8_t state[COMMITMENT_STATE_LEN]) {
+    for (int i = 0; i < set->address_count; i++) {
+        SnapshotAddress record;
+        memset(&record, 0, sizeof(record));
+        snprintf(record.address, MAX_ADDRESS_LEN, "%s", set->addresses[i].address);
+        snprintf(record.owner, MAX_ADDRESS_LEN, "%s", owner_name(i));
+        if (!write_hashed(out, sha, &record, sizeof(record))) return false;
+    }
+    if (!write_hashed(out, sha, state, COMMITMENT_STATE_LEN)) return false;
+
+    // Each address's list gives its outputs oldest first. Locked outputs are
+    // in no list; they go last and come back unlocked.
+    OutputBuffer *buffer = malloc(sizeof(OutputBuffer));
+    if (!buffer) return false;
+    buffer->out = out;
+    buffer->sha = sha;
+    buffer->count = 0;
+    buffer->saved = 0;
+    buffer->ok = true;
+    for (int a = 0; a < set->address_count; a++) {
+        for (int i = set->addresses[a].head; i != -1; i = set->next_by_address[i]) {
+            save_output(buffer, set, i);
+        }
+    }
+    for (int i = 0; i < set->count; i++) {
+        if (set->locked[i]) save_output(buffer, set, i);
+    }
+    bool ok = buffer->ok && buffer->saved == set->count &&
+              write_hashed(out, sha, buffer->records, sizeof(SavedOutput) * buffer->count);
+    free(buffer);
+    return ok;
+}
+
+bool utxo_snapshot_save(const char *path, UtxoSet *set, uint32_t last_txid, SnapshotOwnerName owner_name) {
+    SnapshotHeader header;
+    uint8_t state[COMMITMENT_STATE_LEN];
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SNAPSHOT_VERSION;
+    header.last_txid = last_txid;
+    header.address_count = set->address_count;
+    header.output_count = set->count;
+    if (!utxo_set_commitment_state(set, state)) return false;
+    SHA256(state, COMMITMENT_STATE_LEN, header.commitment);
+
+    char temp[4096];
+    snprintf(temp, sizeof(temp), "%s.tmp", path);
+    FILE *out = fopen(temp, "wb");
+    EVP_MD_CTX *sha = EVP_MD_CTX_new();
+    if (!out || !sha) {
+        if (out) fclose(out);
+        EVP_MD_CTX_free(sha);
+        return false;
+    }
+
+    // Header last: its checksum covers the body
+    bool ok = EVP_DigestInit_ex(sha, EVP_sha256(), NULL) &&
+              fseek(out, sizeof(header), SEEK_SET) == 0 &&
+              write_body(out, sha, set, owner_name, state) &&
+              EVP_DigestFinal_ex(sha, header.checksum, NULL) &&
+              fseek(out, 0, SEEK_SET) == 0 &&
+              fwrite(&header, sizeof(header), 1, out) == 1 &&
+              fflush(out) == 0 && fsync(fileno(out)) == 0;
+    EVP_MD_CTX_free(sha);
+    ok = fclose(out) == 0 && ok;
+    if (ok) ok = rename(temp, path) == 0;
+    if (!ok) remove(temp);
+    return ok;
+}
+
+// NULL if the mapped file is a well-formed, undamaged snapshot
+static const char *check_snapshot(const uint8_t *data, size_t size) {
+    const SnapshotHeader *header = (const SnapshotHeader *)data;
+    if (size < sizeof(SnapshotHeader) || memcmp(header->magic, SNAPSHOT_MAGIC, sizeof(header->magic)) != 0) {
+        return "not a snapshot file";
+    }
+    if (header->version != SNAPSHOT_VERSION) return "unsupported version";
+
+    size_t fixed = sizeof(SnapshotHeader) + (size_t)header->address_count * sizeof(SnapshotAddress) +
+                   COMMITMENT_STATE_LEN;
+    if (fixed > size || header->output_count != (size - fixed) / sizeof(SavedOutput) ||
+        (size - fixed) % sizeof(SavedOutput) != 0) {
+        return "size does not match its header (truncated?)";
+    }
+
+    uint8_t digest[SHA256_DIGEST_LENGTH];
+    SHA256(data + sizeof(SnapshotHeader), size - sizeof(SnapshotHeader), digest);
+    if (memcmp(digest, header->checksum, sizeof(digest)) != 0) return "checksum mismatch (corrupt file)";
+
+    const uint8_t *state = data + fixed - COMMITMENT_STATE_LEN;
+    SHA256(state, COMMITMENT_STATE_LEN, digest);
+    if (memcmp(digest, header->commitment, sizeof(digest)) != 0) return "commitment mismatch";
+    return NULL;
+}
+
+static bool has_terminator(const char *text) {
+    return memchr(text, '\0', MAX_ADDRESS_LEN) != NULL && text[0] != '\0';
+}
+
+static const char *load_snapshot(const uint8_t *data, UtxoSet *set, uint32_t *last_txid,
+                                 SnapshotAddOwner add_owner) {
+    const SnapshotHeader *header = (const SnapshotHeader *)data;
+    const SnapshotAddress *addresses = (const SnapshotAddress *)(data + sizeof(SnapshotHeader));
+    const uint8_t *state = (const uint8_t *)(addresses + header->address_count);
+    const SavedOutput *outputs = (const SavedOutput *)(state + COMMITMENT_STATE_LEN);
+
+    for (uint32_t i = 0; i < header->address_count; i++) {
+        if (!has_terminator(addresses[i].address) || !has_terminator(addresses[i].owner)) {
+            return "bad address record";
+        }
+        int id = utxo_set_intern(set, addresses[i].address);
+        if (id != (int)i) return id < 0 ? "out of memory" : "address listed twice";
+        if (!add_owner(id, addresses[i].owner)) return "cannot add user";
+    }
+    if (!utxo_set_load(set, outputs, (long)header->output_count, state)) return "bad output records";
+    *last_txid = header->last_txid;
+    return NULL;
+}
+
+bool utxo_snapshot_restore(const char *path, UtxoSet *set, uint32_t *last_txid, SnapshotAddOwner add_owner) {
+    const char *error = NULL;
+    if (set->count != 0 || set->address_count != 0) error = "the UTXO set is not empty";
+
+    int fd = error ? -1 : open(path, O_RDONLY);
+    struct stat st;
+    if (!error && (fd < 0 || fstat(fd, &st) != 0)) error = "cannot open";
+    if (!error && st.st_size < (off_t)sizeof(SnapshotHeader)) error = "not a snapshot file";
+
+    const uint8_t *data = MAP_FAILED;
+    size_t size = error ? 0 : (size_t)st.st_size;
+    if (!error) {
+        data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) error = "cannot map";
+        else madvise((void *)data, size, MADV_SEQUENTIAL);
+    }
+    if (fd >= 0) close(fd);     // the mapping stays valid
+
+    if (!error) error = check_snapshot(data, size);
+    if (!error) error = load_snapshot(data, set, last_txid, add_owner);
+    if (data != MAP_FAILED) munmap((void *)data, size);
+
+    if (error) {
+        fprintf(stderr, "❌ Snapshot %s rejected: %s\n", path, error);
+        return false;
+    }
+    return true;
+}
+
+bool utxo_snapshot_start(SnapshotWriter *writer, const char *path, UtxoSet *set, uint32_t last_txid,
+                         SnapshotOwnerName owner_name) {
+    utxo_snapshot_collect(writer, false);
+    if (writer->pid != 0) {
+        writer->skipped++;
+        return false;
+    }
+
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    pid_t pid = fork();
+    if (pid == 0) {
+        // Child: _exit so stdio buffers copied from the parent are not flushed twice
+        _exit(utxo_snapshot_save(path, set, last_txid, owner_name) ? 0 : 1);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    if (pid < 0) {
+        writer->failed++;
+        return false;
+    }
+    writer->pid = pid;
+    writer->forks++;
+    writer->fork_seconds += (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9;
+    return true;
+}
+
+int utxo_snapshot_collect(SnapshotWriter *writer, bool wait) {
+    if (writer->pid == 0) return 0;
+    int status;
+    pid_t done = waitpid(writer->pid, &status, wait ? 0 : WNOHANG);
+    if (done == 0) return 0;    // still writing
+    writer->pid = 0;
+    if (done > 0 && WIFEXITED(status) && WEXITSTATUS(status) == 0) {
+        writer->written++;
+        return 1;
+    }
+    writer->failed++;
+    return -1;
+}
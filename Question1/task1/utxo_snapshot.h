@@ -0,0 +1,86 @@
+#ifndef UTXO_SNAPSHOT_H
+#define UTXO_SNAPSHOT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#include "utxo_set.h"
+#include "utxo_commit.h"
+
+// 📸 UTXO set snapshots
+//
+// A snapshot holds everything needed to restart without replaying a single
+// transaction: the live outputs, the address table with each address's
+// owner, the last txid and the commitment state. It is a header followed
+// by fixed-size records in native byte order, like the spent archive:
+//
+//   SnapshotHeader
+//   SnapshotAddress  x address_count   (in address ID order)
+//   commitment state (COMMITMENT_STATE_LEN bytes)
+//   SavedOutput      x output_count    (each address's outputs oldest first)
+//
+// The header holds the SHA-256 of everything after it and the commitment
+// digest. A file whose sizes, checksum or commitment do not match is
+// rejected before anything is loaded.
+
+#define SNAPSHOT_MAGIC "UTXOSNAP"
+#define SNAPSHOT_VERSION 2           // 2: amounts in 64-bit cents
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t last_txid;
+    uint32_t address_count;
+    uint32_t reserved;                  // 0
+    uint64_t output_count;
+    uint8_t commitment[COMMITMENT_LEN]; // SHA-256 of the commitment state
+    uint8_t checksum[32];               // SHA-256 of the rest of the file
+} SnapshotHeader;
+
+typedef struct {
+    char address[MAX_ADDRESS_LEN];
+    char owner[MAX_ADDRESS_LEN];
+} SnapshotAddress;
+
+// Name of the user who owns an address
+typedef const char *(*SnapshotOwnerName)(int address_id);
+
+// Called for every restored address, in ID order; false stops the restore
+typedef bool (*SnapshotAddOwner)(int address_id, const char *owner);
+
+// Write a snapshot of `set` to `path`. It is written to "<path>.tmp" and
+// renamed, so a crash never leaves a half-written snapshot behind.
+bool utxo_snapshot_save(const char *path, UtxoSet *set, uint32_t last_txid, SnapshotOwnerName owner_name);
+
+// Restore a snapshot into an empty set. The file is memory-mapped and
+// checked in place, then the outputs are bulk-loaded straight from the
+// mapping (utxo_set_load) and the commitment state is imported rather than
+// rebuilt. Prints the reason to stderr and returns false if the file is
+// rejected.
+bool utxo_snapshot_restore(const char *path, UtxoSet *set, uint32_t *last_txid, SnapshotAddOwner add_owner);
+
+// 🧵 Background snapshots
+//
+// Saving forks. The child writes the snapshot from its copy-on-write view
+// of the set and exits, while the parent goes on processing transactions:
+// only the fork() call itself pauses the caller. One child at a time.
+typedef struct {
+    pid_t pid;              // child still writing, 0 = none
+    long written;
+    long failed;
+    long skipped;           // asked for while the previous one was still being written
+    long forks;
+    double fork_seconds;    // total time the caller spent in fork()
+} SnapshotWriter;
+
+// Start writing a snapshot in the background; false if one is still being
+// written or fork() failed
+bool utxo_snapshot_start(SnapshotWriter *writer, const char *path, UtxoSet *set, uint32_t last_txid,
+                         SnapshotOwnerName owner_name);
+
+// Reap a finished child: 1 if it wrote its snapshot, -1 if it failed, 0 if
+// none finished. With `wait`, block until the running one is done.
+int utxo_snapshot_collect(SnapshotWriter *writer, bool wait);
+
+#endif
@@ -1,36 +1,175 @@
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
 
-#define MAX_ACCOUNTS 10
-#define MAX_NAME_LEN 50
+// Amounts are whole cents in a 64-bit integer, so balances never drift.
+// Parsing, formatting and the AVX2 sum are shared with the UTXO model.
+#include "../task1/amount.h"
 
-// Define the Account structure
-typedef struct {
-    char name[MAX_NAME_LEN];
-    float balance;
-} Account;
+#define MAX_NAME_LEN 50          // longest name read from input
+#define INITIAL_INDEX_SIZE 64    // name index slots (a power of two)
+#define MIGRATE_STEP 16          // old index slots moved per new account
 
-Account accounts[MAX_ACCOUNTS];
-int accountCount = 0;
+// Accounts as a struct of arrays: account i is accountName(i), balances[i]
+// and nameHashes[i], so sums over all balances read one contiguous array.
+// The arrays double when full; there is no limit on the number of accounts.
+char *nameText = NULL;           // all names back to back, '\0'-terminated
+long nameTextUsed = 0, nameTextCapacity = 0;
+long *nameOffsets = NULL;        // where each account's name starts in nameText
+uint32_t *nameHashes = NULL;
+Amount *balances = NULL;
+int accountCount = 0, accountCapacity = 0;
 
-// Function to add an account
-void addAccount(const char *name, float balance) {
-    if (accountCount < MAX_ACCOUNTS) {
-        strncpy(accounts[accountCount].name, name, MAX_NAME_LEN);
-        accounts[accountCount].balance = balance;
-        accountCount++;
+// 🔎 Name index: open addressing with linear probing, each slot holds an
+// account index + 1 (0 = empty). When it is 3/4 full, a table twice the
+// size takes over and the old one is moved across MIGRATE_STEP slots per
+// new account, so no single addAccount rehashes every name. Until the move
+// is done, lookups try the new table and then the old one.
+int *indexSlots = NULL, *oldSlots = NULL;
+uint32_t indexSize = 0, oldSize = 0, oldMigrated = 0;
+bool batchMode = false;   // running a workload file: no menus or messages
+
+// Function to format an amount for printing (1250 -> "12.50"); four
+// rotating buffers, so one printf can show up to four amounts
+const char *formatAmount(Amount amount) {
+    static char buffers[4][32];
+    static int next = 0;
+    char *out = buffers[next++ % 4];
+    format_amount(amount, out, sizeof(buffers[0]));
+    return out;
+}
+
+// Function to add up every balance (AVX2 when the CPU has it)
+Amount totalSupply() {
+    return amount_sum(balances, accountCount);
+}
+
+const char *accountName(int index) {
+    return nameText + nameOffsets[index];
+}
+
+uint32_t hashName(const char *name) {
+    uint32_t h = 2166136261u;   // FNV-1a
+    for (; *name; name++) {
+        h ^= (unsigned char)*name;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+int probeIndex(const int *slots, uint32_t size, const char *name, uint32_t hash) {
+    uint32_t mask = size - 1;
+    for (uint32_t s = hash & mask; slots[s] != 0; s = (s + 1) & mask) {
+        int index = slots[s] - 1;
+        if (nameHashes[index] == hash && strcmp(accountName(index), name) == 0)
+            return index;
+    }
+    return -1;
+}
+
+void placeInIndex(int *slots, uint32_t size, int index) {
+    uint32_t mask = size - 1, s = nameHashes[index] & mask;
+    while (slots[s] != 0)
+        s = (s + 1) & mask;
+    slots[s] = index + 1;
+}
+
+// Function to move the next few slots of the old index into the new one
+void migrateIndex() {
+    for (int step = 0; step < MIGRATE_STEP && oldMigrated < oldSize; step++, oldMigrated++) {
+        if (oldSlots[oldMigrated] != 0)
+            placeInIndex(indexSlots, indexSize, oldSlots[oldMigrated] - 1);
     }
+    if (oldSlots && oldMigrated == oldSize) {
+        free(oldSlots);
+        oldSlots = NULL;
+        oldSize = 0;
+    }
+}
+
+// Function to start moving to an index twice the size. calloc hands out
+// large blocks as fresh zeroed pages, so this does not clear the table
+// up front either.
+bool growIndex() {
+    while (oldSlots)
+        migrateIndex();
+    uint32_t size = indexSize ? indexSize * 2 : INITIAL_INDEX_SIZE;
+    int *slots = calloc(size, sizeof(int));
+    if (!slots)
+        return false;
+    oldSlots = indexSlots;
+    oldSize = indexSize;
+    oldMigrated = 0;
+    indexSlots = slots;
+    indexSize = size;
+    return true;
+}
+
+// Function to make room for one more account in the arrays
+bool growAccounts(size_t nameLen) {
+    if (accountCount == accountCapacity) {
+        int capacity = accountCapacity ? accountCapacity * 2 : 16;
+        long *offsets = realloc(nameOffsets, sizeof(long) * capacity);
+        if (offsets)
+            nameOffsets = offsets;
+        uint32_t *hashes = realloc(nameHashes, sizeof(uint32_t) * capacity);
+        if (hashes)
+            nameHashes = hashes;
+        Amount *grown = realloc(balances, sizeof(Amount) * capacity);
+        if (grown)
+            balances = grown;
+        if (!offsets || !hashes || !grown)
+            return false;
+        accountCapacity = capacity;
+    }
+    if (nameTextUsed + (long)nameLen + 1 > nameTextCapacity) {
+        long capacity = nameTextCapacity ? nameTextCapacity * 2 : 1024;
+        while (capacity < nameTextUsed + (long)nameLen + 1)
+            capacity *= 2;
+        char *text = realloc(nameText, capacity);
+        if (!text)
+            return false;
+        nameText = text;
+        nameTextCapacity = capacity;
+    }
+    return true;
 }
 
 // Function to find an account index by name
 int findAccountIndex(const char *name) {
-    for (int i = 0; i < accountCount; i++) {
-        if (strcmp(accounts[i].name, name) == 0) {
-            return i;
-        }
-    }
-    return -1; // Not found
+    if (indexSize == 0)
+        return -1;
+    uint32_t hash = hashName(name);
+    int index = probeIndex(indexSlots, indexSize, name, hash);
+    if (index == -1 && oldSlots)
+        index = probeIndex(oldSlots, oldSize, name, hash);
+    return index; // -1 if not found
+}
+
+// Function to add an account
+bool addAccount(const char *name, Amount balance) {
+    if (findAccountIndex(name) != -1)
+        return false;
+    size_t nameLen = strlen(name);
+    if (!growAccounts(nameLen))
+        return false;
+    if ((uint64_t)(accountCount + 1) * 4 > (uint64_t)indexSize * 3 && !growIndex())
+        return false;
+
+    int index = accountCount;
+    nameOffsets[index] = nameTextUsed;
+    memcpy(nameText + nameTextUsed, name, nameLen + 1);
+    nameTextUsed += nameLen + 1;
+    nameHashes[index] = hashName(name);
+    balances[index] = balance;
+    accountCount++;
+
+    placeInIndex(indexSlots, indexSize, index);
+    migrateIndex();
+    return true;
 }
 
 // Function to display all account balances
@@ -40,49 +179,177 @@ void displayBalances() {
     printf("Name\t\tBalance\n");
     printf("-----------------------------\n");
     for (int i = 0; i < accountCount; i++) {
-        printf("%-10s\t%.2f\n", accounts[i].name, accounts[i].balance);
+        printf("%-10s\t%s\n", accountName(i), formatAmount(balances[i]));
     }
     printf("-----------------------------\n");
+    printf("Total\t\t%s\n", formatAmount(totalSupply()));
 }
 
 // Function to transfer funds between accounts
-bool transferFunds(const char *senderName, const char *receiverName, float amount) {
+bool transferFunds(const char *senderName, const char *receiverName, Amount amount) {
     int senderIndex = findAccountIndex(senderName);
     int receiverIndex = findAccountIndex(receiverName);
 
     if (senderIndex == -1 || receiverIndex == -1) {
-        printf("❌ Error: Sender or receiver account not found.\n");
+        if (!batchMode)
+            printf("❌ Error: Sender or receiver account not found.\n");
         return false;
     }
 
     if (amount <= 0) {
-        printf("❌ Error: Amount must be positive.\n");
+        if (!batchMode)
+            printf("❌ Error: Amount must be positive.\n");
         return false;
     }
 
-    if (accounts[senderIndex].balance < amount) {
-        printf("❌ Error: Insufficient balance.\n");
+    if (balances[senderIndex] < amount) {
+        if (!batchMode)
+            printf("❌ Error: Insufficient balance.\n");
+        return false;
+    }
+
+    balances[senderIndex] -= amount;
+    balances[receiverIndex] += amount;
+
+    if (!batchMode)
+        printf("✅ Transfer of %s from %s to %s completed.\n", formatAmount(amount), senderName, receiverName);
+    return true;
+}
+
+// Latency samples (seconds) collected by batch mode
+typedef struct {
+    double *samples;
+    int count;
+    int capacity;
+} LatencyLog;
+
+double nowSeconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+void recordLatency(LatencyLog *log, double seconds) {
+    if (log->count == log->capacity) {
+        int capacity = log->capacity ? log->capacity * 2 : 1024;
+        double *grown = realloc(log->samples, sizeof(double) * capacity);
+        if (!grown)
+            return;
+        log->samples = grown;
+        log->capacity = capacity;
+    }
+    log->samples[log->count++] = seconds;
+}
+
+int compareDoubles(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+double percentile(const double *sorted, int n, double p) {
+    return sorted[(int)(p / 100.0 * (n - 1) + 0.5)];
+}
+
+// Function to run a workload file without the menu. One command per line:
+//   user <name> [balance]         create an account (default balance 0)
+//   tx <from> <to> <amount> ...   transfer between account names
+//   block ...                     ignored (Question2 only)
+// Lines starting with '#' are comments.
+bool runBatch(const char *path) {
+    FILE *in = fopen(path, "r");
+    if (!in) {
+        printf("❌ Error: Cannot open workload %s\n", path);
         return false;
     }
 
-    accounts[senderIndex].balance -= amount;
-    accounts[receiverIndex].balance += amount;
+    long lines = 0, skipped = 0, created = 0, accepted = 0, rejected = 0;
+    LatencyLog latency = {0};
+    char line[4096];
+    Amount supplyBefore = totalSupply(), funded = 0;   // funded: opening balances of new accounts
+
+    batchMode = true;
+    printf("📥 Running workload %s...\n", path);
+    double start = nowSeconds();
 
-    printf("✅ Transfer of %.2f from %s to %s completed.\n", amount, senderName, receiverName);
+    while (fgets(line, sizeof(line), in)) {
+        lines++;
+        char command[16], sender[MAX_NAME_LEN], receiver[MAX_NAME_LEN];
+        char amountText[32] = "0";
+        Amount amount = 0;
+        int consumed = 0;
+        if (sscanf(line, "%15s %n", command, &consumed) < 1 || command[0] == '#')
+            continue;
+
+        if (strcmp(command, "user") == 0) {
+            if (sscanf(line + consumed, "%49s %31s", sender, amountText) >= 1 &&
+                parse_amount(amountText, &amount) && amount >= 0 && addAccount(sender, amount)) {
+                created++;
+                funded += amount;
+            } else
+                skipped++;
+        } else if (strcmp(command, "tx") == 0) {
+            if (sscanf(line + consumed, "%49s %49s %31s", sender, receiver, amountText) != 3 ||
+                !parse_amount(amountText, &amount)) {
+                skipped++;
+                continue;
+            }
+            double t0 = nowSeconds();
+            if (transferFunds(sender, receiver, amount))
+                accepted++;
+            else
+                rejected++;
+            recordLatency(&latency, nowSeconds() - t0);
+        } else if (strcmp(command, "block") != 0) {
+            skipped++;
+        }
+    }
+
+    double elapsed = nowSeconds() - start;
+    double sumStart = nowSeconds();
+    Amount supplyAfter = totalSupply();
+    double sumElapsed = nowSeconds() - sumStart;
+    batchMode = false;
+    fclose(in);
+
+    printf("\n📊 Batch Summary:\n");
+    printf("-----------------------------\n");
+    printf("Lines read:    %ld (%ld skipped)\n", lines, skipped);
+    printf("Accounts:      %ld created, %d total\n", created, accountCount);
+    printf("Transfers:     %ld accepted, %ld rejected\n", accepted, rejected);
+    printf("Total supply:  %s (%.3f ms to add up)\n", formatAmount(supplyAfter), sumElapsed * 1e3);
+    if (supplyAfter != supplyBefore + funded)
+        printf("\033[1;31m⚠️  Supply changed: expected %s\033[0m\n", formatAmount(supplyBefore + funded));
+    printf("Wall time:     %.3f s\n", elapsed);
+    if (elapsed > 0)
+        printf("Throughput:    %.1f transfers/s\n", (accepted + rejected) / elapsed);
+    if (latency.count > 0) {
+        qsort(latency.samples, latency.count, sizeof(double), compareDoubles);
+        printf("Latency:       p50 %.2f us, p90 %.2f us, p99 %.2f us, max %.2f us\n",
+               percentile(latency.samples, latency.count, 50) * 1e6,
+               percentile(latency.samples, latency.count, 90) * 1e6,
+               percentile(latency.samples, latency.count, 99) * 1e6,
+               latency.samples[latency.count - 1] * 1e6);
+    }
+    printf("-----------------------------\n");
+    free(latency.samples);
     return true;
 }
 
-int main() {
+int main(int argc, char *argv[]) {
     // Initialize accounts
-    addAccount("Alice", 100.0);
-    addAccount("Bob", 50.0);
-    addAccount("Charlie", 75.0);
+    addAccount("Alice", 100 * AMOUNT_SCALE);
+    addAccount("Bob", 50 * AMOUNT_SCALE);
+    addAccount("Charlie", 75 * AMOUNT_SCALE);
 
     printf("🚀 Welcome to Ethereum-style Account Model!\n");
 
+    // Non-interactive run: ./account_model_simulation --batch workload.txt
+    if (argc == 3 && strcmp(argv[1], "--batch") == 0)
+        return runBatch(argv[2]) ? 0 : 1;
+
     int choice;
-    char sender[MAX_NAME_LEN], receiver[MAX_NAME_LEN];
-    float amount;
+    char sender[MAX_NAME_LEN], receiver[MAX_NAME_LEN], amountText[32];
+    Amount amount;
 
     while (1) {
         printf("\n===== 📋 Main Menu =====\n");
@@ -104,7 +371,11 @@ int main() {
                 printf("Enter receiver name: ");
                 scanf("%s", receiver);
                 printf("Enter amount to transfer: ");
-                scanf("%f", &amount);
+                scanf("%31s", amountText);
+                if (!parse_amount(amountText, &amount)) {
+                    printf("❌ Error: Amount must be a number with at most two decimals.\n");
+                    break;
+                }
 
                 if (transferFunds(sender, receiver, amount)) {
                     printf("🔄 Updated balances:\n");
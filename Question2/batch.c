@@ -0,0 +1,172 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "batch.h"
+
+int batchMode = 0;
+
+typedef struct LatencyLog {
+    double *samples;        // seconds
+    int count;
+    int capacity;
+} LatencyLog;
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void recordLatency(LatencyLog *log, double seconds) {
+    if (log->count == log->capacity) {
+        int capacity = log->capacity ? log->capacity * 2 : 1024;
+        double *grown = realloc(log->samples, sizeof(double) * capacity);
+        if (!grown)
+            return;
+        log->samples = grown;
+        log->capacity = capacity;
+    }
+    log->samples[log->count++] = seconds;
+}
+
+static int compareDoubles(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static double percentile(const double *sorted, int n, double p) {
+    int rank = (int)(p / 100.0 * (n - 1) + 0.5);
+    return sorted[rank];
+}
+
+const char *parseBatchPath(int argc, char *argv[]) {
+    for (int i = 1; i < argc - 1; i++)
+        if (strcmp(argv[i], "--batch") == 0)
+            return argv[i + 1];
+    return NULL;
+}
+
+// ✂️ Copy `text` without surrounding blanks into `out`
+static void trimCopy(char out[BATCH_TX_LEN], const char *text, size_t len) {
+    while (len > 0 && (*text == ' ' || *text == '\t')) {
+        text++;
+        len--;
+    }
+    while (len > 0 && (text[len - 1] == ' ' || text[len - 1] == '\t'))
+        len--;
+    if (len >= BATCH_TX_LEN)
+        len = BATCH_TX_LEN - 1;
+    memcpy(out, text, len);
+    out[len] = '\0';
+}
+
+typedef struct BatchRun {
+    BatchAddBlock addBlock;
+    char (*pending)[BATCH_TX_LEN];
+    int pendingCount;
+    long blocks, rejected, transactions;
+    LatencyLog latency;
+} BatchRun;
+
+// ⛏️ Mine whatever is queued as one block
+static void flushPending(BatchRun *run) {
+    if (run->pendingCount == 0)
+        return;
+    double start = nowSeconds();
+    if (run->addBlock(run->pending, run->pendingCount)) {
+        run->blocks++;
+        run->transactions += run->pendingCount;
+    } else {
+        run->rejected++;
+    }
+    recordLatency(&run->latency, nowSeconds() - start);
+    run->pendingCount = 0;
+}
+
+int runBatch(const char *path, BatchAddBlock addBlock, int maxPerBlock) {
+    FILE *in = fopen(path, "r");
+    if (!in) {
+        printf("❌ Cannot open workload %s\n", path);
+        return 0;
+    }
+
+    BatchRun run = { 0 };
+    run.addBlock = addBlock;
+    run.pending = maxPerBlock > 0 ? malloc(sizeof(*run.pending) * maxPerBlock) : NULL;
+    if (!run.pending) {
+        printf("❌ Out of memory for a block of %d transactions\n", maxPerBlock);
+        fclose(in);
+        return 0;
+    }
+    long lines = 0, skipped = 0;
+    char *line = NULL;          // grows to fit the longest line, so long
+    size_t lineCapacity = 0;    // "block a | b | ..." lines are read whole
+
+    batchMode = 1;
+    printf("📥 Running workload %s...\n", path);
+    double start = nowSeconds();
+
+    while (getline(&line, &lineCapacity, in) != -1) {
+        lines++;
+        line[strcspn(line, "\r\n")] = '\0';
+        char command[16];
+        int consumed = 0;
+        if (sscanf(line, "%15s %n", command, &consumed) < 1 || command[0] == '#')
+            continue;
+
+        if (strcmp(command, "tx") == 0) {
+            char from[64], to[64], amount[32];
+            if (sscanf(line + consumed, "%63s %63s %31s", from, to, amount) != 3) {
+                skipped++;
+                continue;
+            }
+            snprintf(run.pending[run.pendingCount++], BATCH_TX_LEN, "%s -> %s: %s", from, to, amount);
+            if (run.pendingCount == maxPerBlock)
+                flushPending(&run);
+        } else if (strcmp(command, "block") == 0) {
+            // Explicit transactions get a block of their own; more than
+            // fit in one block spill over into the next
+            const char *text = line + consumed;
+            if (*text)
+                flushPending(&run);
+            while (*text) {
+                size_t len = strcspn(text, "|");
+                trimCopy(run.pending[run.pendingCount++], text, len);
+                text += len + (text[len] == '|');
+                if (run.pendingCount == maxPerBlock)
+                    flushPending(&run);
+            }
+            flushPending(&run);
+        } else if (strcmp(command, "user") != 0) {
+            skipped++;
+        }
+    }
+    flushPending(&run);
+
+    double elapsed = nowSeconds() - start;
+    batchMode = 0;
+    fclose(in);
+    free(line);
+    free(run.pending);
+
+    printf("\n📊 Batch Summary\n");
+    printf("   Lines read      : %ld (%ld skipped)\n", lines, skipped);
+    printf("   Blocks added    : %ld (%ld rejected)\n", run.blocks, run.rejected);
+    printf("   Transactions    : %ld\n", run.transactions);
+    printf("   Wall time       : %.3f s\n", elapsed);
+    if (elapsed > 0)
+        printf("   Throughput      : %.2f blocks/s, %.1f tx/s\n", run.blocks / elapsed, run.transactions / elapsed);
+    LatencyLog *latency = &run.latency;
+    if (latency->count > 0) {
+        qsort(latency->samples, latency->count, sizeof(double), compareDoubles);
+        printf("   Block latency   : p50 %.2f ms, p90 %.2f ms, p99 %.2f ms, max %.2f ms\n",
+               percentile(latency->samples, latency->count, 50) * 1000,
+               percentile(latency->samples, latency->count, 90) * 1000,
+               percentile(latency->samples, latency->count, 99) * 1000,
+               latency->samples[latency->count - 1] * 1000);
+    }
+    free(latency->samples);
+    return 1;
+}
@@ -0,0 +1,39 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+// 📥 Batch / Replay Mode
+//
+// Runs a workload file through a simulator without the menus. The format
+// is shared with the Question1 simulators, one command per line:
+//
+//   # comment
+//   user <name> [balance]               ignored here
+//   tx <from> <to> <amount> [input...]  queued as "from -> to: amount"
+//   block [text | text | ...]           mine the queued transactions; the
+//                                       '|'-separated ones given, if any,
+//                                       go into a block of their own (or
+//                                       several, if they do not fit in one)
+//
+// Queued transactions are mined automatically once a block is full, and
+// any left at the end of the file go into one last block. At the end the
+// run prints throughput and per-block latency.
+
+#define BATCH_TX_LEN 256    // same as MAX_DATA_LEN in every task
+
+// 🔕 Non-zero while a workload runs: tasks skip prompts, delays and
+// per-block output
+extern int batchMode;
+
+// ⚙️ Read "--batch <file>" from the command line (NULL if absent)
+const char *parseBatchPath(int argc, char *argv[]);
+
+// 🧾 Callback that adds one block of `txnCount` transactions to the chain.
+// Returns 0 if the block was rejected.
+typedef int (*BatchAddBlock)(char transactions[][BATCH_TX_LEN], int txnCount);
+
+// 🏃 Stream the workload at `path` through `addBlock`, at most
+// `maxPerBlock` transactions per block. Returns 0 if the file could not be
+// read or memory ran out.
+int runBatch(const char *path, BatchAddBlock addBlock, int maxPerBlock);
+
+#endif
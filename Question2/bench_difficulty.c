@@ -0,0 +1,230 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#include "block.h"
+#include "miner.h"
+
+// 🧪 Difficulty benchmark
+//
+// Mines N independent blocks for every (difficulty, thread count) pair and
+// reports wall time, CPU time, hash rate and attempts against the expected
+// 16^d, with percentiles. Every trial mines a different header (index and
+// timestamp change), so the samples are independent.
+//
+//   ./bench_difficulty [-d min:max[:step]] [-n trials] [-t 1,2,4]
+//                      [--csv file] [--json file] [--backend name]
+//
+// The CSV has one summary row per pair; the JSON also keeps every trial.
+
+#define MAX_THREAD_COUNTS 16
+
+typedef struct Trial {
+    double wall;            // seconds, CLOCK_MONOTONIC
+    double cpu;             // seconds of process CPU time, all threads
+    long long attempts;
+} Trial;
+
+typedef struct Summary {
+    double difficulty;
+    int threads;
+    int trials;
+    double expected;        // 16^d attempts on average
+    double meanAttempts;
+    double hashesPerSec;    // total attempts / total wall time
+    double meanWall, stddevWall, minWall, p50Wall, p90Wall, p99Wall, maxWall;
+    double meanCpu;
+} Summary;
+
+static double clockSeconds(clockid_t clock) {
+    struct timespec ts;
+    clock_gettime(clock, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static int compareDoubles(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+// 📊 Percentile of sorted samples, interpolating between neighbours
+static double percentile(const double *sorted, int n, double p) {
+    double rank = p / 100.0 * (n - 1);
+    int lo = (int)rank;
+    int hi = lo + 1 < n ? lo + 1 : lo;
+    return sorted[lo] + (sorted[hi] - sorted[lo]) * (rank - lo);
+}
+
+static void runTrial(double difficulty, int threads, int trial, Trial *out) {
+    BlockHeader block;
+    memset(&block, 0, sizeof(block));
+    block.version = BLOCK_VERSION;
+    block.index = trial;
+    block.timestamp = 1700000000 + trial;
+    block.bits = difficultyToBits(difficulty);
+
+    BlockBody body;
+    initBlockBody(&body);
+    setBlockTransaction(&block, &body, 0, "benchmark -> test: 1");
+
+    MiningResult result;
+    double cpuStart = clockSeconds(CLOCK_PROCESS_CPUTIME_ID);
+    mineBlockParallel(&block, threads, NULL, &result);
+    out->cpu = clockSeconds(CLOCK_PROCESS_CPUTIME_ID) - cpuStart;
+    out->wall = result.seconds;
+    out->attempts = result.attempts;
+}
+
+static void summarize(double difficulty, int threads, Trial *trials, int n, Summary *s) {
+    double *walls = malloc(sizeof(double) * n);
+    double totalWall = 0, totalCpu = 0, totalAttempts = 0;
+
+    for (int i = 0; i < n; i++) {
+        walls[i] = trials[i].wall;
+        totalWall += trials[i].wall;
+        totalCpu += trials[i].cpu;
+        totalAttempts += trials[i].attempts;
+    }
+    qsort(walls, n, sizeof(double), compareDoubles);
+
+    s->difficulty = difficulty;
+    s->threads = threads;
+    s->trials = n;
+    s->expected = pow(16.0, bitsToDifficulty(difficultyToBits(difficulty)));
+    s->meanAttempts = totalAttempts / n;
+    s->hashesPerSec = totalWall > 0 ? totalAttempts / totalWall : 0;
+    s->meanWall = totalWall / n;
+    s->meanCpu = totalCpu / n;
+
+    double var = 0;
+    for (int i = 0; i < n; i++)
+        var += (walls[i] - s->meanWall) * (walls[i] - s->meanWall);
+    s->stddevWall = n > 1 ? sqrt(var / (n - 1)) : 0;
+
+    s->minWall = walls[0];
+    s->p50Wall = percentile(walls, n, 50);
+    s->p90Wall = percentile(walls, n, 90);
+    s->p99Wall = percentile(walls, n, 99);
+    s->maxWall = walls[n - 1];
+    free(walls);
+}
+
+static int parseThreadList(const char *arg, int counts[MAX_THREAD_COUNTS]) {
+    int n = 0;
+    const char *p = arg;
+    while (*p && n < MAX_THREAD_COUNTS) {
+        int t = atoi(p);
+        if (t > 0)
+            counts[n++] = t;
+        p = strchr(p, ',');
+        if (!p)
+            break;
+        p++;
+    }
+    return n;
+}
+
+int main(int argc, char *argv[]) {
+    selectHashBackend(argc, argv);
+
+    double minDifficulty = 1, maxDifficulty = 5, step = 1;
+    int trials = 10;
+    int threadCounts[MAX_THREAD_COUNTS] = { 1 };
+    int threadCountN = 1;
+    const char *csvPath = NULL, *jsonPath = NULL;
+
+    // Default sweep: one thread and every core
+    int cores = defaultMiningThreads();
+    if (cores > 1)
+        threadCounts[threadCountN++] = cores;
+
+    for (int i = 1; i < argc - 1; i++) {
+        if (strcmp(argv[i], "-d") == 0) {
+            if (sscanf(argv[i + 1], "%lf:%lf:%lf", &minDifficulty, &maxDifficulty, &step) < 2)
+                maxDifficulty = minDifficulty;
+        } else if (strcmp(argv[i], "-n") == 0) {
+            trials = atoi(argv[i + 1]);
+        } else if (strcmp(argv[i], "-t") == 0) {
+            threadCountN = parseThreadList(argv[i + 1], threadCounts);
+        } else if (strcmp(argv[i], "--csv") == 0) {
+            csvPath = argv[i + 1];
+        } else if (strcmp(argv[i], "--json") == 0) {
+            jsonPath = argv[i + 1];
+        }
+    }
+    if (trials < 1)
+        trials = 1;
+    if (step <= 0)
+        step = 1;
+    if (threadCountN == 0) {
+        fprintf(stderr, "❌ No valid thread counts in -t\n");
+        return 1;
+    }
+
+    FILE *csv = csvPath ? fopen(csvPath, "w") : NULL;
+    FILE *json = jsonPath ? fopen(jsonPath, "w") : NULL;
+    if ((csvPath && !csv) || (jsonPath && !json)) {
+        fprintf(stderr, "❌ Cannot open output file\n");
+        return 1;
+    }
+
+    const char *backend = sha256BackendName(sha256ActiveBackend());
+    if (csv)
+        fprintf(csv, "backend,difficulty,threads,trials,expected_attempts,mean_attempts,attempts_ratio,"
+                     "hashes_per_sec,mean_wall_s,stddev_wall_s,min_wall_s,p50_wall_s,p90_wall_s,"
+                     "p99_wall_s,max_wall_s,mean_cpu_s\n");
+    if (json)
+        fprintf(json, "{\n  \"backend\": \"%s\",\n  \"results\": [", backend);
+
+    printf("🧪 Difficulty benchmark (%s backend, %d trial(s) per point)\n", backend, trials);
+    printf("%6s %7s %14s %8s %12s %10s %10s %10s %10s\n",
+           "diff", "threads", "expected", "ratio", "hashes/s", "p50 ms", "p90 ms", "max ms", "cpu ms");
+
+    Trial *samples = malloc(sizeof(Trial) * trials);
+    int first = 1;
+    for (double d = minDifficulty; d <= maxDifficulty + 1e-9; d += step) {
+        for (int t = 0; t < threadCountN; t++) {
+            for (int i = 0; i < trials; i++)
+                runTrial(d, threadCounts[t], i, &samples[i]);
+
+            Summary s;
+            summarize(d, threadCounts[t], samples, trials, &s);
+            printf("%6.2f %7d %14.0f %8.3f %12.0f %10.3f %10.3f %10.3f %10.3f\n",
+                   s.difficulty, s.threads, s.expected, s.meanAttempts / s.expected,
+                   s.hashesPerSec, s.p50Wall * 1000, s.p90Wall * 1000, s.maxWall * 1000, s.meanCpu * 1000);
+            fflush(stdout);
+
+            if (csv)
+                fprintf(csv, "%s,%.2f,%d,%d,%.0f,%.1f,%.4f,%.0f,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f\n",
+                        backend, s.difficulty, s.threads, s.trials, s.expected, s.meanAttempts,
+                        s.meanAttempts / s.expected, s.hashesPerSec, s.meanWall, s.stddevWall,
+                        s.minWall, s.p50Wall, s.p90Wall, s.p99Wall, s.maxWall, s.meanCpu);
+            if (json) {
+                fprintf(json, "%s\n    {\"difficulty\": %.2f, \"threads\": %d, \"trials\": %d, "
+                              "\"expected_attempts\": %.0f, \"mean_attempts\": %.1f, "
+                              "\"hashes_per_sec\": %.0f, \"wall_s\": {\"mean\": %.6f, \"stddev\": %.6f, "
+                              "\"min\": %.6f, \"p50\": %.6f, \"p90\": %.6f, \"p99\": %.6f, \"max\": %.6f}, "
+                              "\"mean_cpu_s\": %.6f, \"samples\": [",
+                        first ? "" : ",", s.difficulty, s.threads, s.trials, s.expected,
+                        s.meanAttempts, s.hashesPerSec, s.meanWall, s.stddevWall, s.minWall,
+                        s.p50Wall, s.p90Wall, s.p99Wall, s.maxWall, s.meanCpu);
+                for (int i = 0; i < trials; i++)
+                    fprintf(json, "%s{\"wall_s\": %.6f, \"cpu_s\": %.6f, \"attempts\": %lld}",
+                            i ? ", " : "", samples[i].wall, samples[i].cpu, samples[i].attempts);
+                fprintf(json, "]}");
+            }
+            first = 0;
+        }
+    }
+    free(samples);
+
+    if (json) {
+        fprintf(json, "\n  ]\n}\n");
+        fclose(json);
+    }
+    if (csv)
+        fclose(csv);
+    return 0;
+}
@@ -0,0 +1,293 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "block.h"
+#include "chain.h"
+#include "miner.h"
+#include "verify.h"
+
+// 🧪 Hashing microbenchmarks
+//
+// Measures the primitives everything else is built on:
+//
+//   sha256       calculateSHA256 on one message, per size, for each
+//                single-message backend (openssl, scalar, shani)
+//   block_build  createBlock without the mining: N setBlockTransaction
+//                calls plus computeBlockHash
+//   block_hash   computeBlockHash alone
+//   verify       verifyChainParallel over a whole chain on one thread,
+//                per chain length (reported per block)
+//
+// Block and verify cases are repeated for every backend the CPU supports.
+//
+// Every case runs a fixed number of iterations (so results are comparable
+// between builds), after a warmup, REPEATS times; the median and the
+// fastest run are reported. The process is pinned to one CPU unless
+// --no-pin is given.
+//
+//   ./bench_hash [--csv out.csv] [--baseline bench_hash_baseline.csv] [--no-pin]
+//
+// With --baseline, each row also shows the change of its median against
+// the matching baseline row; negative is faster.
+
+#define REPEATS 7
+#define MAX_BASELINE_ROWS 128
+
+typedef struct BaselineRow {
+    char name[32];
+    char backend[16];
+    long param;
+    double median;
+} BaselineRow;
+
+static BaselineRow baseline[MAX_BASELINE_ROWS];
+static int baselineCount = 0;
+static FILE *csv = NULL;
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static int compareDoubles(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static void loadBaseline(const char *path) {
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        fprintf(stderr, "⚠️ Cannot read baseline %s\n", path);
+        return;
+    }
+    char line[256];
+    fgets(line, sizeof(line), f);   // column names
+    while (baselineCount < MAX_BASELINE_ROWS && fgets(line, sizeof(line), f)) {
+        BaselineRow *row = &baseline[baselineCount];
+        if (sscanf(line, "%31[^,],%15[^,],%ld,%*d,%lf", row->name, row->backend, &row->param, &row->median) == 4)
+            baselineCount++;
+    }
+    fclose(f);
+}
+
+static const BaselineRow *findBaseline(const char *name, const char *backend, long param) {
+    for (int i = 0; i < baselineCount; i++)
+        if (strcmp(baseline[i].name, name) == 0 && strcmp(baseline[i].backend, backend) == 0 &&
+            baseline[i].param == param)
+            return &baseline[i];
+    return NULL;
+}
+
+// ⏱️ Run `run(ctx, iterations)` after a warmup and report ns per op.
+// `opsPerIteration` turns iterations into operations (blocks for verify);
+// `bytesPerOp` adds a MB/s column when non-zero.
+static void measure(const char *name, long param, void (*run)(void *, int), void *ctx,
+                    int iterations, int opsPerIteration, size_t bytesPerOp) {
+    double samples[REPEATS];
+    const char *backend = sha256BackendName(sha256ActiveBackend());
+
+    run(ctx, iterations / 10 > 0 ? iterations / 10 : 1);
+    for (int r = 0; r < REPEATS; r++) {
+        double start = nowSeconds();
+        run(ctx, iterations);
+        samples[r] = (nowSeconds() - start) * 1e9 / ((double)iterations * opsPerIteration);
+    }
+    qsort(samples, REPEATS, sizeof(double), compareDoubles);
+    double median = samples[REPEATS / 2], best = samples[0];
+
+    char throughput[32] = "";
+    if (bytesPerOp)
+        snprintf(throughput, sizeof(throughput), "%.1f MB/s", bytesPerOp / median * 1e3);
+
+    char change[32] = "";
+    const BaselineRow *row = findBaseline(name, backend, param);
+    if (row && row->median > 0)
+        snprintf(change, sizeof(change), "%+.1f%%", (median / row->median - 1) * 100);
+
+    printf("%-12s %-8s %7ld %10.1f %10.1f %14s %9s\n", name, backend, param, median, best, throughput, change);
+    fflush(stdout);
+    if (csv) {
+        fprintf(csv, "%s,%s,%ld,%d,%.2f,%.2f\n", name, backend, param, iterations, median, best);
+        fflush(csv);
+    }
+}
+
+// 🎯 calculateSHA256 on one buffer
+typedef struct DigestCase {
+    uint8_t *data;
+    size_t len;
+} DigestCase;
+
+static void runDigest(void *arg, int iterations) {
+    DigestCase *c = arg;
+    uint8_t digest[SHA256_DIGEST_LEN];
+    for (int i = 0; i < iterations; i++) {
+        calculateSHA256(c->data, c->len, digest);
+        c->data[0] = digest[0];     // keep each call dependent on the last
+    }
+}
+
+// 🧱 Building and hashing one block
+typedef struct BlockCase {
+    BlockHeader header;
+    BlockBody body;
+    int transactions;
+} BlockCase;
+
+static void runBlockBuild(void *arg, int iterations) {
+    BlockCase *c = arg;
+    for (int i = 0; i < iterations; i++) {
+        initBlockBody(&c->body);
+        for (int t = 0; t < c->transactions; t++)
+            setBlockTransaction(&c->header, &c->body, t, "alice -> bob: 42");
+        c->header.nonce = i;
+        computeBlockHash(&c->header);
+    }
+}
+
+static void runBlockHash(void *arg, int iterations) {
+    BlockCase *c = arg;
+    for (int i = 0; i < iterations; i++) {
+        c->header.nonce = i;
+        computeBlockHash(&c->header);
+    }
+}
+
+// ✅ Full verification of one chain
+static void runVerify(void *arg, int iterations) {
+    Chain *chain = arg;
+    ChainVerifyResult result;
+    for (int i = 0; i < iterations; i++)
+        if (!verifyChainParallel(chain, 0, 1, &result))
+            fprintf(stderr, "❌ Benchmark chain failed verification at %d\n", result.height);
+}
+
+static void buildChain(Chain *chain, int length) {
+    for (int h = 0; h < length; h++) {
+        int height = chainPrepare(chain);
+        BlockHeader *block = chainEditHeader(chain, height);
+        BlockBody *body = chainEditBody(chain, height);
+        block->version = BLOCK_VERSION;
+        block->index = height;
+        block->timestamp = 1700000000 + height;
+        block->bits = difficultyToBits(1);
+        chainTipHash(chain, block->previousHash);
+        for (int t = 0; t < 4; t++) {
+            char tx[MAX_DATA_LEN];
+            snprintf(tx, sizeof(tx), "user%d -> user%d: %d", t, h, t + h);
+            setBlockTransaction(block, body, t, tx);
+        }
+
+        uint8_t target[SHA256_DIGEST_LEN];
+        bitsToTarget(block->bits, target);
+        do {
+            block->nonce++;
+            computeBlockHash(block);
+        } while (!hashMeetsTarget(block->hash, target));
+        chainCommit(chain);
+    }
+}
+
+static void runDigestCases(void) {
+    static const size_t sizes[] = { 32, 64, 96, 256, 1024, 4096, 65536 };
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        DigestCase c;
+        c.len = sizes[i];
+        c.data = calloc(1, c.len);
+        int iterations = (int)((8u << 20) / (c.len < 64 ? 64 : c.len));
+        measure("sha256", (long)c.len, runDigest, &c, iterations, 1, c.len);
+        free(c.data);
+    }
+}
+
+static void runBlockCases(void) {
+    static const int counts[] = { 1, 2, 5, 10 };
+    BlockCase *c = calloc(1, sizeof(BlockCase));
+    c->header.version = BLOCK_VERSION;
+    c->header.timestamp = 1700000000;
+    c->header.bits = difficultyToBits(4);
+
+    for (size_t i = 0; i < sizeof(counts) / sizeof(counts[0]); i++) {
+        c->transactions = counts[i];
+        measure("block_build", counts[i], runBlockBuild, c, 20000, 1, 0);
+    }
+    measure("block_hash", 0, runBlockHash, c, 200000, 1, 0);
+    free(c);
+}
+
+static void runVerifyCases(void) {
+    static const int lengths[] = { 100, 1000, 10000 };
+    for (size_t i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++) {
+        Chain chain;
+        chainInit(&chain);
+        buildChain(&chain, lengths[i]);
+        int iterations = 20000 / lengths[i] > 0 ? 20000 / lengths[i] : 1;
+        measure("verify", lengths[i], runVerify, &chain, iterations, lengths[i], 0);
+        chainFree(&chain);
+    }
+}
+
+int main(int argc, char *argv[]) {
+    int pin = 1;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--no-pin") == 0)
+            pin = 0;
+        else if (strcmp(argv[i], "--baseline") == 0 && i + 1 < argc)
+            loadBaseline(argv[++i]);
+        else if (strcmp(argv[i], "--csv") == 0 && i + 1 < argc && !(csv = fopen(argv[++i], "w"))) {
+            fprintf(stderr, "❌ Cannot write %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    if (pin) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(sched_getcpu() >= 0 ? sched_getcpu() : 0, &set);
+        if (sched_setaffinity(0, sizeof(set), &set) != 0)
+            fprintf(stderr, "⚠️ Could not pin to one CPU; results may be noisier\n");
+    }
+
+    if (csv)
+        fprintf(csv, "case,backend,param,iterations,median_ns,best_ns\n");
+    printf("%-12s %-8s %7s %10s %10s %14s %9s\n", "case", "backend", "param", "median ns", "best ns", "throughput", "vs base");
+    fflush(stdout);
+    if (csv)
+        fflush(csv);
+
+    // The backend is chosen once per process, so each backend gets its own
+    // child. Block and verify cases run under every backend the CPU has, so
+    // the baseline has rows for whichever one a host picks automatically;
+    // sha256 only runs under the single-message ones (the multi-buffer
+    // backends hash single messages exactly like shani or openssl).
+    static const Sha256Backend backends[] = { SHA256_OPENSSL, SHA256_SCALAR, SHA256_SHANI,
+                                              SHA256_AVX2, SHA256_AVX512 };
+    for (size_t i = 0; i < sizeof(backends) / sizeof(backends[0]); i++) {
+        pid_t pid = fork();
+        if (pid == 0) {
+            sha256SelectBackend(backends[i]);
+            if (sha256ActiveBackend() == backends[i]) {
+                if (backends[i] != SHA256_AVX2 && backends[i] != SHA256_AVX512)
+                    runDigestCases();
+                runBlockCases();
+                runVerifyCases();
+            }
+            if (csv)
+                fclose(csv);
+            _exit(0);
+        }
+        if (pid > 0)
+            waitpid(pid, NULL, 0);
+    }
+
+    if (csv)
+        fclose(csv);
+    return 0;
+}
@@ -0,0 +1,83 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "block.h"
+#include "miner.h"
+
+// 🧪 Mining scaling benchmark
+//
+// Measures the hash rate of mineBlockParallel for 1..N threads by mining a
+// fixed template at an unreachable difficulty and cancelling after a fixed
+// wall-clock window, so every thread count does the same kind of work.
+//
+//   ./bench_mining [-t maxThreads] [-s secondsPerPoint] [--backend auto|openssl|scalar|shani|avx2|avx512]
+
+typedef struct Timer {
+    atomic_int *cancel;
+    double seconds;
+} Timer;
+
+static void *cancelAfter(void *arg) {
+    Timer *timer = arg;
+    struct timespec ts;
+    ts.tv_sec = (time_t)timer->seconds;
+    ts.tv_nsec = (long)((timer->seconds - ts.tv_sec) * 1e9);
+    nanosleep(&ts, NULL);
+    atomic_store(timer->cancel, 1);
+    return NULL;
+}
+
+int main(int argc, char *argv[]) {
+    int maxThreads = parseMiningThreads(argc, argv);
+    selectHashBackend(argc, argv);
+    double seconds = 2.0;
+    for (int i = 1; i < argc - 1; i++)
+        if (strcmp(argv[i], "-s") == 0)
+            seconds = atof(argv[i + 1]);
+
+    BlockHeader block;
+    BlockBody body;
+    memset(&block, 0, sizeof(block));
+    block.index = 1;
+    block.timestamp = 1700000000;
+    block.version = BLOCK_VERSION;
+    block.bits = difficultyToBits(63);    // unreachable: runs until cancelled
+    // Full-size transactions (only the merkle root reaches the header)
+    initBlockBody(&body);
+    for (int i = 0; i < MAX_TRANSACTIONS; i++) {
+        char tx[MAX_DATA_LEN];
+        int len = snprintf(tx, MAX_DATA_LEN, "bench%d -> miner: %d ", i, i + 1);
+        memset(tx + len, 'x', MAX_DATA_LEN - 1 - len);
+        tx[MAX_DATA_LEN - 1] = '\0';
+        setBlockTransaction(&block, &body, i, tx);
+    }
+
+    printf("🧪 Mining scaling benchmark (%s backend, %.1fs per point, up to %d threads)\n",
+           sha256BackendName(sha256ActiveBackend()), seconds, maxThreads);
+    printf("threads,hashes,seconds,hashes_per_sec,speedup,efficiency\n");
+
+    double baseRate = 0;
+    for (int t = 1; t <= maxThreads; t++) {
+        atomic_int cancel;
+        atomic_init(&cancel, 0);
+        Timer timer = { &cancel, seconds };
+        pthread_t timerThread;
+        pthread_create(&timerThread, NULL, cancelAfter, &timer);
+
+        MiningResult result;
+        mineBlockParallel(&block, t, &cancel, &result);
+        pthread_join(timerThread, NULL);
+
+        double rate = result.attempts / result.seconds;
+        if (t == 1)
+            baseRate = rate;
+        printf("%d,%lld,%.3f,%.0f,%.2f,%.2f\n", t, result.attempts, result.seconds,
+               rate, rate / baseRate, rate / baseRate / t);
+        fflush(stdout);
+    }
+    return 0;
+}
@@ -0,0 +1,130 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "block.h"
+#include "chain.h"
+#include "miner.h"
+#include "store.h"
+
+// 🧪 Chain file cold-start benchmark
+//
+// Appends cheap blocks (difficulty 1, one transaction) to a fresh chain
+// file and, at every power of ten, closes it, drops it from the page
+// cache and times how long chainStoreOpen takes to bring it back.
+//
+//   ./bench_store [-n maxBlocks] [--chain path] [--backend auto|openssl|scalar|shani|avx2|avx512]
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static double fileMegabytes(const char *path, const char *suffix) {
+    char name[4096];
+    struct stat st;
+    snprintf(name, sizeof(name), "%s%s", path, suffix);
+    return stat(name, &st) == 0 ? st.st_size / (1024.0 * 1024.0) : 0.0;
+}
+
+// 🧹 Ask the kernel to forget the cached file pages (best effort)
+static void dropCache(const char *path, const char *suffix) {
+    char name[4096];
+    snprintf(name, sizeof(name), "%s%s", path, suffix);
+    int fd = open(name, O_RDONLY);
+    if (fd < 0)
+        return;
+    fdatasync(fd);
+    posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    close(fd);
+}
+
+// ⛏️ Mine and append one block
+static int appendBlock(Chain *chain, ChainStore *store) {
+    int height = chainPrepare(chain);
+    if (height < 0)
+        return 0;
+
+    BlockHeader *block = chainEditHeader(chain, height);
+    BlockBody *body = chainEditBody(chain, height);
+    block->version = BLOCK_VERSION;
+    block->index = height;
+    block->timestamp = 1700000000 + height;
+    block->bits = difficultyToBits(1);
+    chainTipHash(chain, block->previousHash);
+
+    char tx[MAX_DATA_LEN];
+    snprintf(tx, sizeof(tx), "bench -> block%d: %d", height, height % 100 + 1);
+    setBlockTransaction(block, body, 0, tx);
+
+    uint8_t target[SHA256_DIGEST_LEN];
+    bitsToTarget(block->bits, target);
+    do {
+        block->nonce++;
+        computeBlockHash(block);
+    } while (!hashMeetsTarget(block->hash, target));
+
+    chainCommit(chain);
+    return chainStoreAppend(store, chain, height);
+}
+
+int main(int argc, char *argv[]) {
+    selectHashBackend(argc, argv);
+    const char *path = parseChainPath(argc, argv, "bench_chain");
+    int maxBlocks = 1000000;
+    for (int i = 1; i < argc - 1; i++)
+        if (strcmp(argv[i], "-n") == 0)
+            maxBlocks = atoi(argv[i + 1]);
+
+    char name[4096];
+    snprintf(name, sizeof(name), "%s.idx", path);
+    unlink(name);
+    snprintf(name, sizeof(name), "%s.dat", path);
+    unlink(name);
+
+    Chain chain;
+    ChainStore store;
+    chainInit(&chain);
+    if (!chainStoreOpen(&store, &chain, path))
+        return 1;
+
+    printf("🧪 Chain file cold-start benchmark (%s, up to %d blocks)\n", path, maxBlocks);
+    printf("blocks,index_mb,body_mb,open_ms,first_body_ms\n");
+
+    for (int size = 1000; size <= maxBlocks; size *= 10) {
+        while (chain.count < size)
+            if (!appendBlock(&chain, &store)) {
+                chainFree(&chain);
+                chainStoreClose(&store);
+                return 1;
+            }
+
+        chainFree(&chain);
+        chainStoreClose(&store);
+        dropCache(path, ".idx");
+        dropCache(path, ".dat");
+
+        double start = nowSeconds();
+        if (!chainStoreOpen(&store, &chain, path))
+            return 1;
+        double opened = nowSeconds();
+
+        // Touching the tip's transactions is the first lazy body read
+        volatile int txCount = chainBody(&chain, chain.count - 1)->transactionCount;
+        (void)txCount;
+        double firstBody = nowSeconds();
+
+        printf("%d,%.1f,%.1f,%.3f,%.3f\n", chain.count, fileMegabytes(path, ".idx"),
+               fileMegabytes(path, ".dat"), (opened - start) * 1000, (firstBody - opened) * 1000);
+        fflush(stdout);
+    }
+
+    chainFree(&chain);
+    chainStoreClose(&store);
+    return 0;
+}
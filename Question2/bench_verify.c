@@ -0,0 +1,92 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "block.h"
+#include "chain.h"
+#include "miner.h"
+#include "verify.h"
+
+// 🧪 Verification scaling benchmark
+//
+// Builds a chain of full-size blocks at difficulty 1 (cheap to mine) and
+// times verifyChainParallel over the whole chain for 1..N threads.
+//
+//   ./bench_verify [-t maxThreads] [-n blocks] [--backend auto|openssl|scalar|shani|avx2|avx512]
+
+// ⛏️ Build a valid chain of `count` blocks
+static int buildChain(Chain *chain, int count) {
+    for (int h = 0; h < count; h++) {
+        int height = chainPrepare(chain);
+        if (height < 0)
+            return 0;
+
+        BlockHeader *block = chainEditHeader(chain, height);
+        BlockBody *body = chainEditBody(chain, height);
+        block->version = BLOCK_VERSION;
+        block->index = height;
+        block->timestamp = 1700000000 + height;
+        block->bits = difficultyToBits(1);
+        chainTipHash(chain, block->previousHash);
+
+        for (int i = 0; i < MAX_TRANSACTIONS; i++) {
+            char tx[MAX_DATA_LEN];
+            int len = snprintf(tx, MAX_DATA_LEN, "bench%d -> block%d: %d ", i, height, i + 1);
+            memset(tx + len, 'x', MAX_DATA_LEN - 1 - len);
+            tx[MAX_DATA_LEN - 1] = '\0';
+            setBlockTransaction(block, body, i, tx);
+        }
+
+        uint8_t target[SHA256_DIGEST_LEN];
+        bitsToTarget(block->bits, target);
+        do {
+            block->nonce++;
+            computeBlockHash(block);
+        } while (!hashMeetsTarget(block->hash, target));
+
+        chainCommit(chain);
+    }
+    return 1;
+}
+
+int main(int argc, char *argv[]) {
+    int maxThreads = parseMiningThreads(argc, argv);
+    selectHashBackend(argc, argv);
+    int blocks = 20000;
+    for (int i = 1; i < argc - 1; i++)
+        if (strcmp(argv[i], "-n") == 0)
+            blocks = atoi(argv[i + 1]);
+    if (blocks <= 0)
+        blocks = 1;
+
+    Chain chain;
+    chainInit(&chain);
+    if (!buildChain(&chain, blocks)) {
+        chainFree(&chain);
+        return 1;
+    }
+
+    printf("🧪 Verification scaling benchmark (%s backend, %d blocks, up to %d threads)\n",
+           sha256BackendName(sha256ActiveBackend()), blocks, maxThreads);
+    printf("threads,blocks,seconds,blocks_per_sec,speedup,efficiency\n");
+
+    double baseRate = 0;
+    for (int t = 1; t <= maxThreads; t++) {
+        ChainVerifyResult result;
+        if (!verifyChainParallel(&chain, 0, t, &result)) {
+            printf("❌ Block %d: %s\n", result.height, chainFaultMessage(result.fault));
+            break;
+        }
+
+        double rate = result.checked / result.seconds;
+        if (t == 1)
+            baseRate = rate;
+        printf("%d,%d,%.3f,%.0f,%.2f,%.2f\n", t, result.checked, result.seconds,
+               rate, rate / baseRate, rate / baseRate / t);
+        fflush(stdout);
+    }
+
+    chainFree(&chain);
+    return 0;
+}
@@ -0,0 +1,186 @@
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "block.h"
+#include "sha256_dispatch.h"
+
+static const char HEX[] = "0123456789abcdef";
+static void putLE32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static void putLE64(uint8_t *p, uint64_t v) {
+    putLE32(p, (uint32_t)v);
+    putLE32(p + 4, (uint32_t)(v >> 32));
+}
+
+// 🎯 SHA-256 Hash Function (dispatched: SHA-NI, SIMD or OpenSSL)
+void calculateSHA256(const void *input, size_t len, uint8_t output[SHA256_DIGEST_LEN]) {
+    sha256Digest(input, len, output);
+}
+
+// 🔤 Hex Encoding (display only)
+void hashToHex(const uint8_t hash[SHA256_DIGEST_LEN], char output[HASH_SIZE]) {
+    for (int i = 0; i < SHA256_DIGEST_LEN; i++) {
+        output[i * 2] = HEX[hash[i] >> 4];
+        output[i * 2 + 1] = HEX[hash[i] & 0x0f];
+    }
+    output[SHA256_DIGEST_LEN * 2] = '\0';
+}
+
+// 🧊 Empty Block Body
+void initBlockBody(BlockBody *body) {
+    body->transactionCount = 0;
+    merkleInit(&body->merkle);
+}
+
+// 🌳 Merkle Root of the Transactions
+void computeMerkleRoot(const BlockBody *body, uint8_t root[SHA256_DIGEST_LEN]) {
+    MerkleTree tree;
+    uint8_t leaf[SHA256_DIGEST_LEN];
+
+    merkleInit(&tree);
+    for (int i = 0; i < body->transactionCount; i++) {
+        merkleLeafHash(body->transactions[i], leaf);
+        merkleSetLeaf(&tree, i, leaf);
+    }
+    merkleRoot(&tree, root);
+}
+
+// ✍️ Add or Replace a Transaction
+int setBlockTransaction(BlockHeader *header, BlockBody *body, int index, const char *transaction) {
+    uint8_t leaf[SHA256_DIGEST_LEN];
+
+    if (index < 0 || index > body->transactionCount || index >= MAX_TRANSACTIONS)
+        return 0;
+
+    if (index == body->transactionCount)
+        body->transactionCount++;
+
+    strncpy(body->transactions[index], transaction, MAX_DATA_LEN - 1);
+    body->transactions[index][MAX_DATA_LEN - 1] = '\0';
+
+    merkleLeafHash(body->transactions[index], leaf);
+    merkleSetLeaf(&body->merkle, index, leaf);
+    merkleRoot(&body->merkle, header->merkleRoot);
+    return 1;
+}
+
+// 🧾 Transaction Inclusion Proof
+int proveTransaction(const BlockBody *body, int index, MerkleProof *proof) {
+    if (index < 0 || index >= body->transactionCount)
+        return 0;
+    return merkleProve(&body->merkle, index, proof);
+}
+
+// 📐 Canonical Header Serialization
+void serializeBlockHeader(const BlockHeader *block, uint8_t out[BLOCK_HEADER_SIZE]) {
+    putLE32(out + 0, block->version);
+    putLE32(out + 4, (uint32_t)block->index);
+    putLE64(out + 8, (uint64_t)(int64_t)block->timestamp);
+    memcpy(out + 16, block->previousHash, SHA256_DIGEST_LEN);
+    memcpy(out + 48, block->merkleRoot, SHA256_DIGEST_LEN);
+    putLE32(out + 80, block->bits);
+    encodeNonceTail(block->extraNonce, block->nonce, out + BLOCK_HEADER_TAIL_OFFSET);
+}
+
+void encodeNonceTail(uint32_t extraNonce, uint64_t nonce, uint8_t out[BLOCK_HEADER_TAIL_SIZE]) {
+    putLE32(out, extraNonce);
+    putLE64(out + 4, nonce);
+}
+
+// 🧱 Midstate: header bytes before the extraNonce
+void hashBlockPrefix(const BlockHeader *block, Sha256Ctx *ctx) {
+    uint8_t header[BLOCK_HEADER_SIZE];
+    serializeBlockHeader(block, header);
+    sha256Init(ctx);
+    sha256Update(ctx, header, BLOCK_HEADER_TAIL_OFFSET);
+}
+
+// 🔢 Append extraNonce and nonce to a copy of the midstate
+void finishBlockHash(const Sha256Ctx *prefix, uint32_t extraNonce, uint64_t nonce,
+                     uint8_t output[SHA256_DIGEST_LEN]) {
+    Sha256Ctx ctx = *prefix;
+    uint8_t bytes[BLOCK_HEADER_TAIL_SIZE];
+
+    encodeNonceTail(extraNonce, nonce, bytes);
+    sha256Update(&ctx, bytes, sizeof(bytes));
+    sha256Final(&ctx, output);
+}
+
+// 🔍 Hash a Block Without Modifying It
+void calculateBlockHash(const BlockHeader *block, uint8_t output[SHA256_DIGEST_LEN]) {
+    Sha256Ctx prefix;
+    hashBlockPrefix(block, &prefix);
+    finishBlockHash(&prefix, block->extraNonce, block->nonce, output);
+}
+
+// 🔧 Compute Hash for a Block
+void computeBlockHash(BlockHeader *block) {
+    calculateBlockHash(block, block->hash);
+}
+
+// 🎚️ Difficulty (leading hex zeros) -> compact target
+uint32_t difficultyToBits(double difficulty) {
+    if (difficulty < 0)
+        difficulty = 0;
+    if (difficulty > 63)
+        difficulty = 63;
+
+    // target ~= 2^log2Target
+    double log2Target = 256.0 - 4.0 * difficulty;
+    int exponent = (int)floor(log2Target / 8.0) + 1;
+    double mantissa = pow(2.0, log2Target - 8.0 * (exponent - 3));
+
+    // Keep the mantissa below the sign bit the compact format reserves
+    while (mantissa >= 0x800000) {
+        mantissa /= 256.0;
+        exponent++;
+    }
+    if (exponent > SHA256_DIGEST_LEN)
+        return ((uint32_t)SHA256_DIGEST_LEN << 24) | 0x7fffff;
+
+    uint32_t m = (uint32_t)mantissa;
+    if (m == 0)
+        m = 1;
+    return ((uint32_t)exponent << 24) | m;
+}
+
+double bitsToDifficulty(uint32_t bits) {
+    int exponent = bits >> 24;
+    uint32_t mantissa = bits & 0x7fffff;
+    if (mantissa == 0)
+        return 64.0;
+    double log2Target = log2((double)mantissa) + 8.0 * (exponent - 3);
+    return (256.0 - log2Target) / 4.0;
+}
+
+void bitsToTarget(uint32_t bits, uint8_t target[SHA256_DIGEST_LEN]) {
+    int exponent = bits >> 24;
+    uint32_t mantissa = bits & 0x7fffff;
+
+    memset(target, 0, SHA256_DIGEST_LEN);
+    if (exponent > SHA256_DIGEST_LEN)
+        exponent = SHA256_DIGEST_LEN;
+
+    if (exponent <= 3) {
+        mantissa >>= 8 * (3 - exponent);
+        target[SHA256_DIGEST_LEN - 3] = (uint8_t)(mantissa >> 16);
+        target[SHA256_DIGEST_LEN - 2] = (uint8_t)(mantissa >> 8);
+        target[SHA256_DIGEST_LEN - 1] = (uint8_t)mantissa;
+        return;
+    }
+
+    int pos = SHA256_DIGEST_LEN - exponent;
+    target[pos] = (uint8_t)(mantissa >> 16);
+    target[pos + 1] = (uint8_t)(mantissa >> 8);
+    target[pos + 2] = (uint8_t)mantissa;
+}
+
+// ✅ Big-endian byte order makes memcmp a numeric comparison
+int hashMeetsTarget(const uint8_t hash[SHA256_DIGEST_LEN], const uint8_t target[SHA256_DIGEST_LEN]) {
+    return memcmp(hash, target, SHA256_DIGEST_LEN) <= 0;
+}
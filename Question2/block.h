@@ -0,0 +1,121 @@
+#ifndef BLOCK_H
+#define BLOCK_H
+
+#include <stdint.h>
+#include <time.h>
+
+#include "sha256.h"
+#include "merkle.h"
+
+#define MAX_TRANSACTIONS 10
+#define MAX_DATA_LEN 256
+#define HASH_SIZE 65        // hex string: 64 chars + '\0' (display only)
+
+// 📐 Canonical block header: every field at a fixed offset, little-endian
+//
+//   offset  size  field
+//        0     4  version
+//        4     4  index
+//        8     8  timestamp
+//       16    32  previousHash
+//       48    32  merkleRoot
+//       80     4  bits
+//       84     4  extraNonce
+//       88     8  nonce
+//
+// The block hash is SHA-256 of these 96 bytes. The first 64 bytes fill
+// exactly one SHA-256 block, and the 12 bytes a miner varies (extraNonce
+// and nonce) come last, so a miner compresses that block once and patches
+// only the tail for each attempt. Together with the timestamp they are
+// rolled like one counter: nonce first, then extraNonce, then timestamp.
+#define BLOCK_VERSION 2
+#define BLOCK_HEADER_SIZE 96
+#define BLOCK_HEADER_TAIL_OFFSET 84
+#define BLOCK_HEADER_TAIL_SIZE 12
+
+_Static_assert(MAX_TRANSACTIONS <= MERKLE_MAX_LEAVES, "merkle tree too small for a block");
+
+// 🔥 Hot part of a block: everything hashing, mining and linkage checks
+// read. Three cache lines, so a scan over a header array never touches
+// transaction text.
+typedef struct BlockHeader {
+    uint32_t version;
+    int index;
+    time_t timestamp;
+    uint8_t previousHash[SHA256_DIGEST_LEN];
+    uint8_t merkleRoot[SHA256_DIGEST_LEN];  // commits to the body's transactions
+    uint8_t hash[SHA256_DIGEST_LEN];
+    uint32_t bits;          // compact proof-of-work target (Bitcoin nBits)
+    uint32_t extraNonce;    // next 32 bits of search space once nonce runs out
+    uint64_t nonce;
+    uint64_t bodyOffset;    // 💾 body record in the chain file (not hashed)
+} __attribute__((aligned(64))) BlockHeader;
+
+_Static_assert(sizeof(BlockHeader) == 192, "header index entries are three cache lines");
+
+// 🧊 Cold part of a block: transaction text and its merkle tree
+typedef struct BlockBody {
+    int transactionCount;
+    char transactions[MAX_TRANSACTIONS][MAX_DATA_LEN];
+    MerkleTree merkle;                      // kept in step with transactions[]
+} BlockBody;
+
+// 🎯 SHA-256 of `len` bytes into a raw 32-byte digest
+void calculateSHA256(const void *input, size_t len, uint8_t output[SHA256_DIGEST_LEN]);
+
+// 🔤 Hex-encode a digest for display (64 chars + '\0')
+void hashToHex(const uint8_t hash[SHA256_DIGEST_LEN], char output[HASH_SIZE]);
+
+// 🧊 Empty body (no transactions, empty tree)
+void initBlockBody(BlockBody *body);
+
+// 🌳 Merkle root of a body's transactions, rebuilt from the text.
+// Verifiers use this instead of trusting body->merkle.
+void computeMerkleRoot(const BlockBody *body, uint8_t root[SHA256_DIGEST_LEN]);
+
+// ✍️ Add (index == transactionCount) or replace a transaction. The merkle
+// tree and header->merkleRoot are updated along one path in O(log n).
+// Returns 0 if the index is out of range or the block is full.
+int setBlockTransaction(BlockHeader *header, BlockBody *body, int index, const char *transaction);
+
+// 🧾 Inclusion proof for transaction `index`, checkable with merkleVerify
+// against the header's merkleRoot alone. Returns 0 if out of range.
+int proveTransaction(const BlockBody *body, int index, MerkleProof *proof);
+
+// 📐 Write the canonical header (see layout above)
+void serializeBlockHeader(const BlockHeader *block, uint8_t out[BLOCK_HEADER_SIZE]);
+
+// 🧱 Absorb the header up to the extraNonce into `ctx`. The result is the
+// block's midstate: it only changes when a header field other than
+// extraNonce and nonce does.
+void hashBlockPrefix(const BlockHeader *block, Sha256Ctx *ctx);
+
+// 🔢 Little-endian extraNonce and nonce bytes as they appear in the header
+void encodeNonceTail(uint32_t extraNonce, uint64_t nonce, uint8_t out[BLOCK_HEADER_TAIL_SIZE]);
+
+// 🔢 Finish a copy of a midstate with `extraNonce` and `nonce`
+void finishBlockHash(const Sha256Ctx *prefix, uint32_t extraNonce, uint64_t nonce,
+                     uint8_t output[SHA256_DIGEST_LEN]);
+
+// 🔍 Hash a block without modifying it
+void calculateBlockHash(const BlockHeader *block, uint8_t output[SHA256_DIGEST_LEN]);
+
+// 🔧 Hash a block's fields into block->hash
+void computeBlockHash(BlockHeader *block);
+
+// 🎚️ Proof-of-work targets
+//
+// A target is a 256-bit big-endian number; a hash meets it when the hash,
+// read as a big-endian number, is <= target. Blocks store the target in
+// Bitcoin's compact form: 1 exponent byte E and a 23-bit mantissa M, with
+// target = M * 256^(E-3).
+//
+// Difficulty is expressed as "leading hex zeros" so the old integer levels
+// keep their meaning (difficulty d needs ~16^d attempts), but fractional
+// levels such as 4.5 are now possible.
+uint32_t difficultyToBits(double difficulty);
+double bitsToDifficulty(uint32_t bits);
+void bitsToTarget(uint32_t bits, uint8_t target[SHA256_DIGEST_LEN]);
+int hashMeetsTarget(const uint8_t hash[SHA256_DIGEST_LEN], const uint8_t target[SHA256_DIGEST_LEN]);
+
+#endif
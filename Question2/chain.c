@@ -0,0 +1,168 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#include "chain.h"
+
+#define CHAIN_INITIAL_CAPACITY 64
+
+void chainInit(Chain *chain) {
+    chain->headers = NULL;
+    chain->bodies = NULL;
+    chain->count = 0;
+    chain->capacity = 0;
+    chain->verified = 0;
+    chain->minimumBits = 0;
+    chain->headerMap = NULL;
+    chain->headerMapLength = 0;
+    chain->loadBody = NULL;
+    chain->loadContext = NULL;
+}
+
+static void releaseHeaders(Chain *chain) {
+    if (chain->headerMap)
+        munmap(chain->headerMap, chain->headerMapLength);
+    else
+        free(chain->headers);
+    chain->headerMap = NULL;
+    chain->headerMapLength = 0;
+}
+
+void chainFree(Chain *chain) {
+    releaseHeaders(chain);
+    for (int i = 0; i < chain->capacity && chain->bodies; i++)
+        free(chain->bodies[i]);
+    free(chain->bodies);
+    chainInit(chain);
+}
+
+// 📈 Double both arrays. Headers keep their 64-byte alignment, which
+// realloc does not promise, so they are moved with aligned_alloc. A
+// mapped header array is copied out of the file the first time it grows.
+static int chainGrow(Chain *chain) {
+    int capacity = chain->capacity ? chain->capacity * 2 : CHAIN_INITIAL_CAPACITY;
+
+    BlockHeader *headers = aligned_alloc(_Alignof(BlockHeader), sizeof(BlockHeader) * capacity);
+    if (!headers)
+        return 0;
+    BlockBody **bodies = realloc(chain->bodies, sizeof(BlockBody *) * capacity);
+    if (!bodies) {
+        free(headers);
+        return 0;
+    }
+    memset(bodies + chain->capacity, 0, sizeof(BlockBody *) * (capacity - chain->capacity));
+
+    if (chain->count)
+        memcpy(headers, chain->headers, sizeof(BlockHeader) * chain->count);
+    releaseHeaders(chain);
+
+    chain->headers = headers;
+    chain->bodies = bodies;
+    chain->capacity = capacity;
+    return 1;
+}
+
+int chainPrepare(Chain *chain) {
+    if (chain->count == chain->capacity && !chainGrow(chain)) {
+        fprintf(stderr, "❌ Out of memory growing the chain past %d blocks\n", chain->count);
+        return -1;
+    }
+
+    int height = chain->count;
+    if (!chain->bodies[height] && !(chain->bodies[height] = malloc(sizeof(BlockBody)))) {
+        fprintf(stderr, "❌ Out of memory for block %d\n", height);
+        return -1;
+    }
+    memset(&chain->headers[height], 0, sizeof(BlockHeader));
+    initBlockBody(chain->bodies[height]);
+    return height;
+}
+
+void chainCommit(Chain *chain) {
+    chain->count++;
+}
+
+const BlockHeader *chainHeader(const Chain *chain, int height) {
+    return &chain->headers[height];
+}
+
+static void loadBody(const Chain *chain, int height, BlockBody *body) {
+    initBlockBody(body);
+    if (!chain->loadBody || !chain->loadBody(chain->loadContext, height, chain->headers + height, body))
+        fprintf(stderr, "⚠️ Could not load the transactions of block %d\n", height);
+}
+
+// 🧊 Bodies of a chain opened from a file are read on first use. The body
+// cache is not part of the chain's value, so this is done through a const
+// chain; different heights may be loaded from different threads at once.
+static BlockBody *fetchBody(const Chain *chain, int height) {
+    static BlockBody unavailable;       // zeroed == empty body
+
+    BlockBody **slot = &chain->bodies[height];
+    if (*slot)
+        return *slot;
+
+    BlockBody *body = malloc(sizeof(BlockBody));
+    if (!body) {
+        fprintf(stderr, "❌ Out of memory loading block %d\n", height);
+        return &unavailable;
+    }
+    loadBody(chain, height, body);
+    *slot = body;
+    return body;
+}
+
+const BlockBody *chainBody(const Chain *chain, int height) {
+    return fetchBody(chain, height);
+}
+
+const BlockBody *chainReadBody(const Chain *chain, int height, BlockBody *scratch) {
+    if (chain->bodies[height])
+        return chain->bodies[height];
+    loadBody(chain, height, scratch);
+    return scratch;
+}
+
+// 📉 Anything at or above an edited height must be verified again
+static void chainInvalidate(Chain *chain, int height) {
+    if (height < chain->verified)
+        chain->verified = height;
+}
+
+BlockHeader *chainEditHeader(Chain *chain, int height) {
+    chainInvalidate(chain, height);
+    return &chain->headers[height];
+}
+
+BlockBody *chainEditBody(Chain *chain, int height) {
+    chainInvalidate(chain, height);
+    return fetchBody(chain, height);
+}
+
+int chainReplaceTransaction(Chain *chain, int height, int index, const char *transaction) {
+    if (height < 0 || height >= chain->count)
+        return 0;
+    if (index < 0 || index >= chainBody(chain, height)->transactionCount)
+        return 0;
+    return setBlockTransaction(chainEditHeader(chain, height), chainEditBody(chain, height),
+                               index, transaction);
+}
+
+uint32_t chainMinimumBits(const Chain *chain) {
+    return chain->minimumBits ? chain->minimumBits : difficultyToBits(CHAIN_MIN_DIFFICULTY);
+}
+
+void chainTipHash(const Chain *chain, uint8_t hash[SHA256_DIGEST_LEN]) {
+    if (chain->count == 0)
+        memset(hash, 0, SHA256_DIGEST_LEN);
+    else
+        memcpy(hash, chain->headers[chain->count - 1].hash, SHA256_DIGEST_LEN);
+}
+
+int chainFindBrokenLink(const Chain *chain) {
+    for (int i = 1; i < chain->count; i++)
+        if (memcmp(chain->headers[i].previousHash, chain->headers[i - 1].hash, SHA256_DIGEST_LEN) != 0)
+            return i;
+    return -1;
+}
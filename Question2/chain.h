@@ -0,0 +1,80 @@
+#ifndef CHAIN_H
+#define CHAIN_H
+
+#include "block.h"
+
+#define CHAIN_MIN_DIFFICULTY 1.0    // floor when minimumBits is 0
+
+// ⛓️ Growable Chain Storage
+//
+// Headers and bodies live in two separate arrays that grow by doubling, so
+// there is no fixed block limit. Linkage checks, hashing and mining only
+// walk `headers` (192 bytes per block); the ~3 KB bodies are touched only
+// when transactions are read.
+//
+// Blocks are built in place: chainPrepare hands out the next slot, the
+// caller fills and mines it there, and chainCommit makes it part of the
+// chain. An uncommitted slot is simply reused by the next chainPrepare.
+//
+// `minimumBits` is the easiest target a block may declare; verification
+// rejects blocks with an easier one (0 = CHAIN_MIN_DIFFICULTY).
+//
+// `verified` is a checkpoint: blocks below it have passed verification and
+// have not been edited since. Read access is const; the chainEdit*
+// accessors are the only way to get a writable block, and they pull the
+// checkpoint back to the edited height.
+//
+// A chain opened from a chain file (store.h) starts with `headers` pointing
+// into a private mapping of the file's header index and every body slot
+// empty; bodies are read through `loadBody` and kept once they are shown
+// or edited (chainBody), while verification reads them into a scratch
+// body (chainReadBody).
+typedef struct Chain {
+    BlockHeader *headers;
+    BlockBody **bodies;     // NULL until a block's body is created or loaded
+    int count;
+    int capacity;
+    int verified;           // blocks [0, verified) are known to be valid
+    uint32_t minimumBits;   // easiest allowed target (compact), 0 = default
+
+    void *headerMap;        // mapping `headers` lives in, or NULL if malloc'd
+    size_t headerMapLength;
+    int (*loadBody)(void *context, int height, const BlockHeader *header, BlockBody *body);
+    void *loadContext;
+} Chain;
+
+void chainInit(Chain *chain);
+void chainFree(Chain *chain);
+
+// 🧱 Next slot at height chain->count, with a zeroed header and an empty
+// body. Returns the height, or -1 if memory ran out.
+int chainPrepare(Chain *chain);
+void chainCommit(Chain *chain);
+
+const BlockHeader *chainHeader(const Chain *chain, int height);
+const BlockBody *chainBody(const Chain *chain, int height);
+
+// 📖 Like chainBody, but a body that is not in memory yet is read into
+// `scratch` and not kept. Verification uses this, so a pass over a whole
+// mapped chain holds one body per thread instead of every body.
+const BlockBody *chainReadBody(const Chain *chain, int height, BlockBody *scratch);
+
+// ✏️ Writable access; invalidates the checkpoint from `height` up
+BlockHeader *chainEditHeader(Chain *chain, int height);
+BlockBody *chainEditBody(Chain *chain, int height);
+
+// ✏️ Replace transaction `index` of a committed block in place (header
+// merkleRoot follows, the stored hash does not). Returns 0 if out of range.
+int chainReplaceTransaction(Chain *chain, int height, int index, const char *transaction);
+
+// 🎯 minimumBits, or the CHAIN_MIN_DIFFICULTY default when it is 0
+uint32_t chainMinimumBits(const Chain *chain);
+
+// 🔗 Hash of the last committed block (all zeros for an empty chain)
+void chainTipHash(const Chain *chain, uint8_t hash[SHA256_DIGEST_LEN]);
+
+// 🔗 Header-only scan: every previousHash must equal the prior block's
+// hash. Returns the first height that breaks the link, or -1.
+int chainFindBrokenLink(const Chain *chain);
+
+#endif
@@ -0,0 +1,111 @@
+#include <string.h>
+
+#include "merkle.h"
+#include "sha256_dispatch.h"
+
+// Level L starts after the full-capacity levels below it: 0, 16, 24, 28, 30
+static int levelOffset(int level) {
+    int offset = 0;
+    for (int l = 0; l < level; l++)
+        offset += MERKLE_MAX_LEAVES >> l;
+    return offset;
+}
+
+static uint8_t *node(MerkleTree *tree, int level, int index) {
+    return tree->nodes[levelOffset(level) + index];
+}
+
+static const uint8_t *constNode(const MerkleTree *tree, int level, int index) {
+    return tree->nodes[levelOffset(level) + index];
+}
+
+static void hashPair(const uint8_t left[SHA256_DIGEST_LEN], const uint8_t right[SHA256_DIGEST_LEN],
+                     uint8_t out[SHA256_DIGEST_LEN]) {
+    uint8_t pair[2 * SHA256_DIGEST_LEN];
+    memcpy(pair, left, SHA256_DIGEST_LEN);
+    memcpy(pair + SHA256_DIGEST_LEN, right, SHA256_DIGEST_LEN);
+    sha256Digest(pair, sizeof(pair), out);
+}
+
+void merkleInit(MerkleTree *tree) {
+    tree->leafCount = 0;
+    tree->levelCount = 0;
+    memset(tree->levelSize, 0, sizeof(tree->levelSize));
+}
+
+void merkleLeafHash(const char *transaction, uint8_t leaf[SHA256_DIGEST_LEN]) {
+    sha256Digest(transaction, strlen(transaction), leaf);
+}
+
+int merkleSetLeaf(MerkleTree *tree, int index, const uint8_t leaf[SHA256_DIGEST_LEN]) {
+    if (index < 0 || index > tree->leafCount || index >= MERKLE_MAX_LEAVES)
+        return 0;
+
+    if (index == tree->leafCount) {
+        tree->leafCount++;
+        // Level sizes only grow along the right edge: ceil(size / 2) per level
+        int size = tree->leafCount, level = 0;
+        while (1) {
+            tree->levelSize[level] = size;
+            if (size == 1)
+                break;
+            size = (size + 1) / 2;
+            level++;
+        }
+        tree->levelCount = level + 1;
+    }
+
+    memcpy(node(tree, 0, index), leaf, SHA256_DIGEST_LEN);
+
+    // Rehash the path; the last node of a level pairs with itself
+    for (int level = 0; level + 1 < tree->levelCount; level++) {
+        int left = index & ~1;
+        int right = left + 1 < tree->levelSize[level] ? left + 1 : left;
+        index /= 2;
+        hashPair(node(tree, level, left), node(tree, level, right), node(tree, level + 1, index));
+    }
+    return 1;
+}
+
+void merkleRoot(const MerkleTree *tree, uint8_t root[SHA256_DIGEST_LEN]) {
+    if (tree->levelCount == 0) {
+        memset(root, 0, SHA256_DIGEST_LEN);
+        return;
+    }
+    memcpy(root, constNode(tree, tree->levelCount - 1, 0), SHA256_DIGEST_LEN);
+}
+
+int merkleProve(const MerkleTree *tree, int index, MerkleProof *proof) {
+    if (index < 0 || index >= tree->leafCount)
+        return 0;
+
+    proof->index = index;
+    proof->length = 0;
+    for (int level = 0; level + 1 < tree->levelCount; level++) {
+        int sibling = index ^ 1;
+        if (sibling >= tree->levelSize[level])
+            sibling = index;
+        memcpy(proof->siblings[proof->length++], constNode(tree, level, sibling), SHA256_DIGEST_LEN);
+        index /= 2;
+    }
+    return 1;
+}
+
+int merkleVerify(const uint8_t leaf[SHA256_DIGEST_LEN], const MerkleProof *proof,
+                 const uint8_t root[SHA256_DIGEST_LEN]) {
+    uint8_t current[SHA256_DIGEST_LEN];
+    int index = proof->index;
+
+    if (proof->length < 0 || proof->length > MERKLE_MAX_LEVELS)
+        return 0;
+
+    memcpy(current, leaf, SHA256_DIGEST_LEN);
+    for (int i = 0; i < proof->length; i++) {
+        if (index & 1)
+            hashPair(proof->siblings[i], current, current);
+        else
+            hashPair(current, proof->siblings[i], current);
+        index /= 2;
+    }
+    return index == 0 && memcmp(current, root, SHA256_DIGEST_LEN) == 0;
+}
@@ -0,0 +1,51 @@
+#ifndef MERKLE_H
+#define MERKLE_H
+
+#include <stdint.h>
+
+#include "sha256.h"
+
+#define MERKLE_MAX_LEAVES 16
+#define MERKLE_MAX_LEVELS 5     // log2(MERKLE_MAX_LEAVES) + 1
+#define MERKLE_MAX_NODES (2 * MERKLE_MAX_LEAVES - 1)
+
+// 🌳 Merkle Tree
+//
+// Leaves are SHA-256 of each transaction; a parent is SHA-256(left || right)
+// and an odd node at the end of a level is paired with itself. All levels
+// are kept, so changing or appending one leaf only rehashes the path to the
+// root: O(log n) instead of rebuilding the tree.
+typedef struct MerkleTree {
+    int leafCount;
+    int levelCount;                         // 0 when empty, 1 for a single leaf
+    int levelSize[MERKLE_MAX_LEVELS];
+    uint8_t nodes[MERKLE_MAX_NODES][SHA256_DIGEST_LEN];
+} MerkleTree;
+
+// 🧾 Inclusion proof: the sibling at every level from leaf to root
+typedef struct MerkleProof {
+    int index;                              // leaf position
+    int length;                             // number of siblings
+    uint8_t siblings[MERKLE_MAX_LEVELS][SHA256_DIGEST_LEN];
+} MerkleProof;
+
+void merkleInit(MerkleTree *tree);
+
+// Hash a transaction into a leaf
+void merkleLeafHash(const char *transaction, uint8_t leaf[SHA256_DIGEST_LEN]);
+
+// Append a leaf (index == leafCount) or replace an existing one, then
+// rehash its path. Returns 0 if the index is out of range or the tree is full.
+int merkleSetLeaf(MerkleTree *tree, int index, const uint8_t leaf[SHA256_DIGEST_LEN]);
+
+// Root of the tree (all zeros when empty)
+void merkleRoot(const MerkleTree *tree, uint8_t root[SHA256_DIGEST_LEN]);
+
+// Build the inclusion proof for leaf `index`. Returns 0 if out of range.
+int merkleProve(const MerkleTree *tree, int index, MerkleProof *proof);
+
+// Check a proof against a root using only the leaf, the proof and the root
+int merkleVerify(const uint8_t leaf[SHA256_DIGEST_LEN], const MerkleProof *proof,
+                 const uint8_t root[SHA256_DIGEST_LEN]);
+
+#endif
@@ -0,0 +1,215 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "miner.h"
+#include "sha256_simd.h"
+
+int miningThreads = 0;
+
+// 🧠 Shared state for one mining run
+typedef struct MiningJob {
+    const BlockHeader *block;
+    Sha256Ctx prefix;           // midstate of everything but extraNonce and nonce
+    uint8_t target[SHA256_DIGEST_LEN];
+    int lanes;                  // attempts per hashing call
+    atomic_int *cancel;
+    atomic_int done;            // set by the winner (or on cancel) to stop everyone
+    atomic_ullong nextUnit;     // next work unit to hand out
+    atomic_llong attempts;
+    MiningResult *result;
+} MiningJob;
+
+// 📦 One work unit: MINING_UNIT_NONCES nonces under one extraNonce/timestamp
+typedef struct WorkUnit {
+    time_t timestamp;
+    uint32_t extraNonce;
+    uint64_t nonceStart;
+} WorkUnit;
+
+typedef struct MiningWorker {
+    MiningJob *job;
+    pthread_t thread;
+} MiningWorker;
+
+int defaultMiningThreads(void) {
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+}
+
+int parseMiningThreads(int argc, char *argv[]) {
+    for (int i = 1; i < argc - 1; i++) {
+        if (strcmp(argv[i], "-t") == 0 || strcmp(argv[i], "--threads") == 0) {
+            int n = atoi(argv[i + 1]);
+            if (n > 0)
+                return n;
+            fprintf(stderr, "⚠️ Ignoring invalid thread count '%s'\n", argv[i + 1]);
+        }
+    }
+    return defaultMiningThreads();
+}
+
+void selectHashBackend(int argc, char *argv[]) {
+    Sha256Backend backend = SHA256_AUTO;
+    for (int i = 1; i < argc - 1; i++) {
+        if (strcmp(argv[i], "--backend") != 0)
+            continue;
+        int parsed = sha256ParseBackend(argv[i + 1]);
+        if (parsed < 0)
+            fprintf(stderr, "⚠️ Unknown backend '%s', choosing automatically\n", argv[i + 1]);
+        else
+            backend = (Sha256Backend)parsed;
+    }
+    sha256SelectBackend(backend);
+}
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static int shouldStop(MiningJob *job) {
+    if (atomic_load_explicit(&job->done, memory_order_relaxed))
+        return 1;
+    if (job->cancel && atomic_load_explicit(job->cancel, memory_order_relaxed)) {
+        atomic_store_explicit(&job->done, 1, memory_order_relaxed);
+        return 1;
+    }
+    return 0;
+}
+
+// 🏆 First worker to get here wins; the rest stop on their next check
+static void claimResult(MiningJob *job, const WorkUnit *unit, uint64_t nonce,
+                        const uint8_t hash[SHA256_DIGEST_LEN]) {
+    int expected = 0;
+    if (atomic_compare_exchange_strong(&job->done, &expected, 1)) {
+        job->result->found = 1;
+        job->result->nonce = nonce;
+        job->result->extraNonce = unit->extraNonce;
+        job->result->timestamp = unit->timestamp;
+        memcpy(job->result->hash, hash, SHA256_DIGEST_LEN);
+    }
+}
+
+// 🎟️ Hand out the next unit. Unit u covers nonces starting at
+// u * MINING_UNIT_NONCES; every 2^64 nonces carry into extraNonce, and
+// every 2^32 extraNonces carry into the timestamp.
+static void claimWorkUnit(MiningJob *job, WorkUnit *unit) {
+    const int unitBits = 20;                // log2(MINING_UNIT_NONCES)
+    uint64_t u = atomic_fetch_add(&job->nextUnit, 1);
+
+    uint64_t extra = (uint64_t)job->block->extraNonce + (u >> (64 - unitBits));
+    unit->nonceStart = u << unitBits;
+    unit->extraNonce = (uint32_t)extra;
+    unit->timestamp = job->block->timestamp + (time_t)(extra >> 32);
+}
+
+// ⛏️ Worker: claims work units until someone wins or the run is cancelled.
+// The extraNonce and nonce are the fixed-size tail of the header, so every
+// attempt in a batch has the same shape and goes to the multi-buffer
+// kernel as is.
+static void *mineWorker(void *arg) {
+    MiningWorker *worker = arg;
+    MiningJob *job = worker->job;
+    long long tried = 0;
+
+    uint8_t tailBytes[SHA256_MAX_LANES][BLOCK_HEADER_TAIL_SIZE];
+    const uint8_t *tails[SHA256_MAX_LANES];
+    uint8_t hashes[SHA256_MAX_LANES][SHA256_DIGEST_LEN];
+
+    for (int lane = 0; lane < SHA256_MAX_LANES; lane++)
+        tails[lane] = tailBytes[lane];
+
+    while (!shouldStop(job)) {
+        WorkUnit unit;
+        claimWorkUnit(job, &unit);
+
+        // A rolled timestamp is in the first SHA-256 block: new midstate
+        Sha256Ctx rolled;
+        const Sha256Ctx *prefix = &job->prefix;
+        if (unit.timestamp != job->block->timestamp) {
+            BlockHeader header = *job->block;
+            header.timestamp = unit.timestamp;
+            hashBlockPrefix(&header, &rolled);
+            prefix = &rolled;
+        }
+
+        int winner = -1;
+        uint64_t nonce = unit.nonceStart;
+        for (uint64_t n = 0; n < MINING_UNIT_NONCES && winner < 0 && !shouldStop(job); n += job->lanes) {
+            nonce = unit.nonceStart + n;
+            for (int lane = 0; lane < job->lanes; lane++)
+                encodeNonceTail(unit.extraNonce, nonce + lane, tailBytes[lane]);
+
+            if (!(job->lanes > 1 && sha256FinishMulti(prefix, tails, BLOCK_HEADER_TAIL_SIZE, hashes))) {
+                for (int lane = 0; lane < job->lanes; lane++)
+                    finishBlockHash(prefix, unit.extraNonce, nonce + lane, hashes[lane]);
+            }
+            tried += job->lanes;
+
+            for (int lane = 0; lane < job->lanes && winner < 0; lane++)
+                if (hashMeetsTarget(hashes[lane], job->target))
+                    winner = lane;
+        }
+
+        if (winner >= 0) {
+            claimResult(job, &unit, nonce + winner, hashes[winner]);
+            break;
+        }
+    }
+
+    atomic_fetch_add(&job->attempts, tried);
+    return NULL;
+}
+
+int mineBlockParallel(const BlockHeader *block, int threadCount,
+                      atomic_int *cancel, MiningResult *result) {
+    if (threadCount <= 0)
+        threadCount = defaultMiningThreads();
+
+    memset(result, 0, sizeof(*result));
+
+    MiningJob job;
+    job.block = block;
+    job.lanes = sha256MultiLanes();
+    hashBlockPrefix(block, &job.prefix);
+    bitsToTarget(block->bits, job.target);
+    job.cancel = cancel;
+    job.result = result;
+    atomic_init(&job.done, 0);
+    atomic_init(&job.nextUnit, 0);
+    atomic_init(&job.attempts, 0);
+
+    MiningWorker *workers = malloc(sizeof(MiningWorker) * threadCount);
+    if (!workers) {
+        fprintf(stderr, "❌ Out of memory starting %d mining threads\n", threadCount);
+        return 0;
+    }
+
+    double start = nowSeconds();
+    int started = 0;
+    for (int i = 0; i < threadCount; i++) {
+        workers[i].job = &job;
+        if (pthread_create(&workers[i].thread, NULL, mineWorker, &workers[i]) != 0)
+            break;
+        started++;
+    }
+
+    // Fall back to mining on this thread if no worker could be started
+    if (started == 0) {
+        workers[0].job = &job;
+        mineWorker(&workers[0]);
+    }
+
+    for (int i = 0; i < started; i++)
+        pthread_join(workers[i].thread, NULL);
+
+    result->seconds = nowSeconds() - start;
+    result->attempts = atomic_load(&job.attempts);
+    free(workers);
+    return result->found;
+}
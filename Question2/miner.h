@@ -0,0 +1,48 @@
+#ifndef MINER_H
+#define MINER_H
+
+#include <stdatomic.h>
+
+#include "block.h"
+#include "sha256_dispatch.h"
+
+#define MINING_UNIT_NONCES (1ULL << 20)     // nonces per work unit
+
+typedef struct MiningResult {
+    int found;              // 1 if a nonce meeting the difficulty was found
+    uint64_t nonce;         // winning nonce
+    uint32_t extraNonce;    // extraNonce it was found under
+    time_t timestamp;       // header timestamp, later than the template's if it rolled
+    uint8_t hash[SHA256_DIGEST_LEN];   // winning hash
+    long long attempts;     // hashes tried across all threads
+    double seconds;         // wall-clock time spent mining
+} MiningResult;
+
+// 🧵 Worker threads used by mineBlock (defaults to the online CPU count)
+extern int miningThreads;
+
+int defaultMiningThreads(void);
+
+// ⚙️ Read "-t N" / "--threads N" from the command line (default: CPU count)
+int parseMiningThreads(int argc, char *argv[]);
+
+// ⚙️ Read "--backend auto|openssl|scalar|shani|avx2|avx512" from the command
+// line and select that SHA-256 backend (default: auto)
+void selectHashBackend(int argc, char *argv[]);
+
+// ⛏️ Search the nonce space of `block` with `threadCount` workers until a
+// hash meeting the target in block->bits is found or `*cancel` becomes
+// non-zero. `block` is only read; the winning nonce, extraNonce, timestamp
+// and hash are returned in `result`. `cancel` may be NULL. Returns
+// result->found.
+//
+// The search space is (timestamp, extraNonce, nonce) counted as one number
+// starting at (block->timestamp, block->extraNonce, 0). Workers claim
+// disjoint work units of MINING_UNIT_NONCES consecutive nonces from a
+// shared counter, so no two attempts overlap; when the 64-bit nonce wraps
+// the next unit moves to the next extraNonce, and when that wraps, to the
+// next second.
+int mineBlockParallel(const BlockHeader *block, int threadCount,
+                      atomic_int *cancel, MiningResult *result);
+
+#endif
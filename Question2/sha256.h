@@ -0,0 +1,33 @@
+#ifndef SHA256_H
+#define SHA256_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define SHA256_BLOCK_LEN 64
+#define SHA256_DIGEST_LEN 32
+
+// 🧮 Streaming SHA-256 whose intermediate state can be copied.
+// Copying a context after hashing a fixed prefix gives a "midstate": each
+// later message sharing that prefix only has to hash its own tail.
+typedef struct Sha256Ctx {
+    uint32_t state[8];
+    uint64_t length;                    // total bytes absorbed
+    uint8_t buffer[SHA256_BLOCK_LEN];   // pending partial block
+    size_t bufferLen;
+} Sha256Ctx;
+
+void sha256Init(Sha256Ctx *ctx);
+void sha256Update(Sha256Ctx *ctx, const void *data, size_t len);
+void sha256Final(Sha256Ctx *ctx, uint8_t digest[SHA256_DIGEST_LEN]);
+
+// Round constants, shared with the SIMD kernels
+extern const uint32_t sha256K[64];
+
+// 🔁 Compress `count` consecutive 64-byte blocks into `state`.
+// sha256CompressBlocks points at the portable C version until
+// sha256SelectBackend (sha256_dispatch.h) swaps in a faster one.
+void sha256CompressBlocksPortable(uint32_t state[8], const uint8_t *blocks, size_t count);
+extern void (*sha256CompressBlocks)(uint32_t state[8], const uint8_t *blocks, size_t count);
+
+#endif
@@ -0,0 +1,222 @@
+// OpenSSL 3 deprecates the low-level SHA256_* calls, but SHA256_Update on
+// a seeded SHA256_CTX is the only way to run its compression on a midstate
+#define OPENSSL_SUPPRESS_DEPRECATED
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <openssl/sha.h>
+
+#include "sha256_dispatch.h"
+#include "sha256_simd.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+
+typedef int (*MultiFinish)(const Sha256Ctx *, const uint8_t *const[], size_t,
+                           uint8_t[][SHA256_DIGEST_LEN]);
+
+typedef struct CpuFeatures {
+    int shaNi;
+    int avx2;
+    int avx512;
+} CpuFeatures;
+
+static Sha256Backend activeBackend = SHA256_OPENSSL;
+static int multiLanes = 1;
+static MultiFinish multiFinish = NULL;
+static atomic_int selected;
+static pthread_mutex_t selectLock = PTHREAD_MUTEX_INITIALIZER;
+
+static const char *const NAMES[] = { "auto", "openssl", "scalar", "shani", "avx2", "avx512" };
+
+const char *sha256BackendName(Sha256Backend backend) {
+    return NAMES[backend];
+}
+
+int sha256ParseBackend(const char *name) {
+    for (int i = 0; i < (int)(sizeof(NAMES) / sizeof(NAMES[0])); i++)
+        if (strcmp(name, NAMES[i]) == 0)
+            return i;
+    return -1;
+}
+
+// 🔎 CPUID Probe
+//
+// AVX state must also be enabled by the OS (XCR0), otherwise the
+// instructions fault even though CPUID advertises them.
+static CpuFeatures probeCpu(void) {
+    CpuFeatures cpu = {0, 0, 0};
+#if defined(__x86_64__) || defined(__i386__)
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+        return cpu;
+
+    int sse41 = (ecx >> 19) & 1;
+    int ssse3 = (ecx >> 9) & 1;
+    int osxsave = (ecx >> 27) & 1;
+    int avx = (ecx >> 28) & 1;
+
+    unsigned long long xcr0 = 0;
+    if (osxsave) {
+        unsigned int lo, hi;
+        __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+        xcr0 = ((unsigned long long)hi << 32) | lo;
+    }
+    int osAvx = avx && (xcr0 & 0x6) == 0x6;             // XMM + YMM
+    int osAvx512 = osAvx && (xcr0 & 0xe0) == 0xe0;      // opmask + ZMM
+
+    if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx))
+        return cpu;
+
+    cpu.shaNi = ((ebx >> 29) & 1) && sse41 && ssse3;
+    cpu.avx2 = ((ebx >> 5) & 1) && osAvx;
+    cpu.avx512 = ((ebx >> 16) & 1) && osAvx512;
+#endif
+    return cpu;
+}
+
+static int supported(Sha256Backend backend, CpuFeatures cpu) {
+    switch (backend) {
+        case SHA256_SHANI: return cpu.shaNi;
+        case SHA256_AVX2: return cpu.avx2;
+        case SHA256_AVX512: return cpu.avx512;
+        case SHA256_OPENSSL:
+        case SHA256_SCALAR: return 1;
+        default: return 0;
+    }
+}
+
+// Fastest first. On nonce batches the multi-buffer kernels out-run
+// single-buffer SHA-NI (bench_mining, one core: avx512 14.4M/s, avx2
+// 8.0M/s, shani 5.9M/s), and single messages still use SHA-NI under them.
+static Sha256Backend pickFastest(CpuFeatures cpu) {
+    if (cpu.avx512) return SHA256_AVX512;
+    if (cpu.avx2) return SHA256_AVX2;
+    if (cpu.shaNi) return SHA256_SHANI;
+    return SHA256_OPENSSL;
+}
+
+// 🧪 Only enable a kernel after it matches OpenSSL on this machine
+static int passesSelfTest(Sha256Backend backend, CpuFeatures cpu) {
+    if (cpu.shaNi && backend != SHA256_SCALAR && backend != SHA256_OPENSSL && !sha256ShaNiSelfTest())
+        return 0;
+    if (backend == SHA256_AVX2)
+        return sha256MultiSelfTest("AVX2", SHA256_AVX2_LANES, sha256FinishAvx2);
+    if (backend == SHA256_AVX512)
+        return sha256MultiSelfTest("AVX-512", SHA256_AVX512_LANES, sha256FinishAvx512);
+    return 1;
+}
+
+// Compress whole blocks with OpenSSL's assembly: seed a context with the
+// state, and since it holds no partial block, SHA256_Update compresses the
+// blocks straight through
+static void compressOpenSsl(uint32_t state[8], const uint8_t *blocks, size_t count) {
+    SHA256_CTX ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    memcpy(ctx.h, state, sizeof(ctx.h));
+    ctx.md_len = SHA256_DIGEST_LENGTH;
+    SHA256_Update(&ctx, blocks, count * SHA256_BLOCK_LEN);
+    memcpy(state, ctx.h, sizeof(ctx.h));
+}
+
+static void install(Sha256Backend backend, CpuFeatures cpu) {
+    activeBackend = backend;
+    multiLanes = 1;
+    multiFinish = NULL;
+
+    // Single-message compression: SHA-NI whenever a hardware backend is in
+    // use. Without it OpenSSL's assembly beats the portable C (bench_hash,
+    // about 5x at 1 KiB), so single messages and midstates go through
+    // OpenSSL and the SIMD kernels only finish nonce batches.
+    if (backend == SHA256_SCALAR)
+        sha256CompressBlocks = sha256CompressBlocksPortable;
+    else if (cpu.shaNi && backend != SHA256_OPENSSL)
+        sha256CompressBlocks = sha256CompressShaNi;
+    else
+        sha256CompressBlocks = compressOpenSsl;
+
+    if (backend == SHA256_AVX2) {
+        multiLanes = SHA256_AVX2_LANES;
+        multiFinish = sha256FinishAvx2;
+    } else if (backend == SHA256_AVX512) {
+        multiLanes = SHA256_AVX512_LANES;
+        multiFinish = sha256FinishAvx512;
+    }
+}
+
+void sha256SelectBackend(Sha256Backend requested) {
+    pthread_mutex_lock(&selectLock);
+    if (atomic_load(&selected)) {
+        pthread_mutex_unlock(&selectLock);
+        return;
+    }
+
+    CpuFeatures cpu = probeCpu();
+    const char *env = getenv("SHA256_BACKEND");
+    if (requested == SHA256_AUTO && env && *env) {
+        int parsed = sha256ParseBackend(env);
+        if (parsed < 0)
+            fprintf(stderr, "⚠️ Unknown SHA256_BACKEND '%s', choosing automatically\n", env);
+        else
+            requested = (Sha256Backend)parsed;
+    }
+
+    Sha256Backend backend = requested;
+    if (backend != SHA256_AUTO && !supported(backend, cpu)) {
+        fprintf(stderr, "⚠️ This CPU does not support the %s backend, choosing automatically\n",
+                sha256BackendName(backend));
+        backend = SHA256_AUTO;
+    }
+    if (backend == SHA256_AUTO)
+        backend = pickFastest(cpu);
+
+    if (!passesSelfTest(backend, cpu)) {
+        fprintf(stderr, "⚠️ %s SHA-256 failed its self-test, using OpenSSL\n",
+                sha256BackendName(backend));
+        backend = SHA256_OPENSSL;
+        cpu.shaNi = 0;
+    }
+
+    install(backend, cpu);
+    atomic_store(&selected, 1);
+    pthread_mutex_unlock(&selectLock);
+}
+
+static void ensureSelected(void) {
+    if (!atomic_load_explicit(&selected, memory_order_acquire))
+        sha256SelectBackend(SHA256_AUTO);
+}
+
+Sha256Backend sha256ActiveBackend(void) {
+    ensureSelected();
+    return activeBackend;
+}
+
+void sha256Digest(const void *data, size_t len, uint8_t digest[SHA256_DIGEST_LEN]) {
+    ensureSelected();
+    // SHA256() pays about 700 ns of EVP setup per call, so the other
+    // backends hash through a context even when it compresses with OpenSSL
+    if (activeBackend == SHA256_OPENSSL) {
+        SHA256(data, len, digest);
+        return;
+    }
+
+    Sha256Ctx ctx;
+    sha256Init(&ctx);
+    sha256Update(&ctx, data, len);
+    sha256Final(&ctx, digest);
+}
+
+int sha256MultiLanes(void) {
+    ensureSelected();
+    return multiLanes;
+}
+
+int sha256FinishMulti(const Sha256Ctx *prefix, const uint8_t *const tails[], size_t tailLen,
+                      uint8_t digests[][SHA256_DIGEST_LEN]) {
+    return multiFinish && multiFinish(prefix, tails, tailLen, digests);
+}
@@ -0,0 +1,53 @@
+#ifndef SHA256_DISPATCH_H
+#define SHA256_DISPATCH_H
+
+#include "sha256.h"
+
+// 🧭 SHA-256 backend dispatcher
+//
+// Probes CPUID once and picks the fastest implementation this machine
+// supports. Everything that hashes (calculateSHA256, block hashing, the
+// miner and the verifiers) goes through it.
+//
+//   SHA256_AVX512  16-lane multi-buffer for nonce batches
+//   SHA256_AVX2    8-lane multi-buffer for nonce batches
+//   SHA256_SHANI   Intel SHA extensions, single buffer
+//   SHA256_OPENSSL OpenSSL's SHA256() (always available)
+//   SHA256_SCALAR  portable C, mainly for comparison
+//
+// The multi-buffer backends only help when many equal-length messages are
+// hashed at once (mining). Single messages and midstates under them use
+// SHA-NI when the CPU has it, and OpenSSL otherwise (also for
+// SHA256_OPENSSL); only SHA256_SCALAR runs the portable C code.
+typedef enum Sha256Backend {
+    SHA256_AUTO,
+    SHA256_OPENSSL,
+    SHA256_SCALAR,
+    SHA256_SHANI,
+    SHA256_AVX2,
+    SHA256_AVX512
+} Sha256Backend;
+
+// ⚙️ Choose a backend. SHA256_AUTO honours $SHA256_BACKEND and otherwise
+// picks the fastest supported one. A forced backend the CPU lacks, or one
+// that fails its self-test against OpenSSL, falls back to the automatic
+// choice. Call before starting threads; later calls are ignored.
+void sha256SelectBackend(Sha256Backend requested);
+
+Sha256Backend sha256ActiveBackend(void);
+const char *sha256BackendName(Sha256Backend backend);
+
+// "auto", "openssl", "scalar", "shani", "avx2" or "avx512"; -1 if unknown
+int sha256ParseBackend(const char *name);
+
+// 🎯 One-shot digest through the active backend
+void sha256Digest(const void *data, size_t len, uint8_t digest[SHA256_DIGEST_LEN]);
+
+// 🚀 Multi-buffer finishing for the active backend (lanes == 1 when the
+// backend has no multi-buffer kernel). Returns 0 if the batch could not be
+// hashed that way; the caller then hashes each lane on its own.
+int sha256MultiLanes(void);
+int sha256FinishMulti(const Sha256Ctx *prefix, const uint8_t *const tails[], size_t tailLen,
+                      uint8_t digests[][SHA256_DIGEST_LEN]);
+
+#endif
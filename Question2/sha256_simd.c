@@ -0,0 +1,351 @@
+#include <stdio.h>
+#include <string.h>
+#include <openssl/sha.h>
+
+#include "sha256_simd.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SHA256_SIMD_X86 1
+#endif
+
+// A tail plus padding spans at most this many blocks per lane
+#define SIMD_MAX_TAIL 128
+#define SIMD_MAX_BLOCKS 4
+
+static uint32_t loadBE32(const uint8_t *p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+static void storeBE32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+}
+
+// 📦 Build each lane's final padded block(s) and transpose them into
+// words[block][word][lane]. Returns the number of blocks (same for all lanes).
+static int prepareLanes(const Sha256Ctx *prefix, const uint8_t *const tails[], size_t tailLen,
+                        int lanes, uint32_t words[SIMD_MAX_BLOCKS][16][SHA256_MAX_LANES]) {
+    uint8_t buf[SIMD_MAX_BLOCKS * SHA256_BLOCK_LEN];
+    size_t used = prefix->bufferLen + tailLen;
+    int blocks = (int)((used + 9 + SHA256_BLOCK_LEN - 1) / SHA256_BLOCK_LEN);
+    size_t total = (size_t)blocks * SHA256_BLOCK_LEN;
+    uint64_t bits = (prefix->length + tailLen) * 8;
+
+    memcpy(buf, prefix->buffer, prefix->bufferLen);
+    for (int lane = 0; lane < lanes; lane++) {
+        memcpy(buf + prefix->bufferLen, tails[lane], tailLen);
+        buf[used] = 0x80;
+        memset(buf + used + 1, 0, total - used - 1 - 8);
+        storeBE32(buf + total - 8, (uint32_t)(bits >> 32));
+        storeBE32(buf + total - 4, (uint32_t)bits);
+
+        for (int b = 0; b < blocks; b++)
+            for (int i = 0; i < 16; i++)
+                words[b][i][lane] = loadBE32(buf + b * SHA256_BLOCK_LEN + i * 4);
+    }
+    return blocks;
+}
+
+static int fitsKernel(const Sha256Ctx *prefix, size_t tailLen) {
+    return tailLen <= SIMD_MAX_TAIL &&
+           prefix->bufferLen + tailLen + 9 <= SIMD_MAX_BLOCKS * SHA256_BLOCK_LEN;
+}
+
+#ifdef SHA256_SIMD_X86
+
+// ⚡ AVX2: 8 lanes of 32-bit words in one __m256i
+
+#define ROTR8(x, n) _mm256_or_si256(_mm256_srli_epi32((x), (n)), _mm256_slli_epi32((x), 32 - (n)))
+
+__attribute__((target("avx2")))
+static void compressAvx2(__m256i s[8], uint32_t words[16][SHA256_MAX_LANES]) {
+    __m256i w[16];
+    for (int i = 0; i < 16; i++)
+        w[i] = _mm256_loadu_si256((const __m256i *)words[i]);
+
+    __m256i a = s[0], b = s[1], c = s[2], d = s[3];
+    __m256i e = s[4], f = s[5], g = s[6], h = s[7];
+
+    for (int i = 0; i < 64; i++) {
+        if (i >= 16) {
+            __m256i w15 = w[(i + 1) & 15], w2 = w[(i + 14) & 15];
+            __m256i s0 = _mm256_xor_si256(_mm256_xor_si256(ROTR8(w15, 7), ROTR8(w15, 18)),
+                                          _mm256_srli_epi32(w15, 3));
+            __m256i s1 = _mm256_xor_si256(_mm256_xor_si256(ROTR8(w2, 17), ROTR8(w2, 19)),
+                                          _mm256_srli_epi32(w2, 10));
+            w[i & 15] = _mm256_add_epi32(_mm256_add_epi32(w[i & 15], s0),
+                                         _mm256_add_epi32(w[(i + 9) & 15], s1));
+        }
+
+        __m256i S1 = _mm256_xor_si256(_mm256_xor_si256(ROTR8(e, 6), ROTR8(e, 11)), ROTR8(e, 25));
+        __m256i ch = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+        __m256i t1 = _mm256_add_epi32(_mm256_add_epi32(h, S1),
+                                      _mm256_add_epi32(_mm256_add_epi32(ch, w[i & 15]),
+                                                       _mm256_set1_epi32((int)sha256K[i])));
+        __m256i S0 = _mm256_xor_si256(_mm256_xor_si256(ROTR8(a, 2), ROTR8(a, 13)), ROTR8(a, 22));
+        __m256i maj = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_or_si256(a, b)));
+        __m256i t2 = _mm256_add_epi32(S0, maj);
+
+        h = g; g = f; f = e; e = _mm256_add_epi32(d, t1);
+        d = c; c = b; b = a; a = _mm256_add_epi32(t1, t2);
+    }
+
+    s[0] = _mm256_add_epi32(s[0], a); s[1] = _mm256_add_epi32(s[1], b);
+    s[2] = _mm256_add_epi32(s[2], c); s[3] = _mm256_add_epi32(s[3], d);
+    s[4] = _mm256_add_epi32(s[4], e); s[5] = _mm256_add_epi32(s[5], f);
+    s[6] = _mm256_add_epi32(s[6], g); s[7] = _mm256_add_epi32(s[7], h);
+}
+
+__attribute__((target("avx2")))
+static void finishAvx2(const Sha256Ctx *prefix, const uint8_t *const tails[], size_t tailLen,
+                       uint8_t digests[][SHA256_DIGEST_LEN]) {
+    uint32_t words[SIMD_MAX_BLOCKS][16][SHA256_MAX_LANES];
+    uint32_t out[8][8];
+    __m256i s[8];
+
+    int blocks = prepareLanes(prefix, tails, tailLen, 8, words);
+    for (int i = 0; i < 8; i++)
+        s[i] = _mm256_set1_epi32((int)prefix->state[i]);
+    for (int b = 0; b < blocks; b++)
+        compressAvx2(s, words[b]);
+
+    for (int i = 0; i < 8; i++)
+        _mm256_storeu_si256((__m256i *)out[i], s[i]);
+    for (int lane = 0; lane < 8; lane++)
+        for (int i = 0; i < 8; i++)
+            storeBE32(digests[lane] + i * 4, out[i][lane]);
+}
+
+// ⚡ AVX-512: 16 lanes, native rotates and ternary logic for Ch/Maj
+
+#define ROTR16(x, n) _mm512_ror_epi32((x), (n))
+
+__attribute__((target("avx512f")))
+static void compressAvx512(__m512i s[8], uint32_t words[16][SHA256_MAX_LANES]) {
+    __m512i w[16];
+    for (int i = 0; i < 16; i++)
+        w[i] = _mm512_loadu_si512((const void *)words[i]);
+
+    __m512i a = s[0], b = s[1], c = s[2], d = s[3];
+    __m512i e = s[4], f = s[5], g = s[6], h = s[7];
+
+    for (int i = 0; i < 64; i++) {
+        if (i >= 16) {
+            __m512i w15 = w[(i + 1) & 15], w2 = w[(i + 14) & 15];
+            __m512i s0 = _mm512_ternarylogic_epi32(ROTR16(w15, 7), ROTR16(w15, 18),
+                                                   _mm512_srli_epi32(w15, 3), 0x96);
+            __m512i s1 = _mm512_ternarylogic_epi32(ROTR16(w2, 17), ROTR16(w2, 19),
+                                                   _mm512_srli_epi32(w2, 10), 0x96);
+            w[i & 15] = _mm512_add_epi32(_mm512_add_epi32(w[i & 15], s0),
+                                         _mm512_add_epi32(w[(i + 9) & 15], s1));
+        }
+
+        __m512i S1 = _mm512_ternarylogic_epi32(ROTR16(e, 6), ROTR16(e, 11), ROTR16(e, 25), 0x96);
+        __m512i ch = _mm512_ternarylogic_epi32(e, f, g, 0xca);
+        __m512i t1 = _mm512_add_epi32(_mm512_add_epi32(h, S1),
+                                      _mm512_add_epi32(_mm512_add_epi32(ch, w[i & 15]),
+                                                       _mm512_set1_epi32((int)sha256K[i])));
+        __m512i S0 = _mm512_ternarylogic_epi32(ROTR16(a, 2), ROTR16(a, 13), ROTR16(a, 22), 0x96);
+        __m512i maj = _mm512_ternarylogic_epi32(a, b, c, 0xe8);
+        __m512i t2 = _mm512_add_epi32(S0, maj);
+
+        h = g; g = f; f = e; e = _mm512_add_epi32(d, t1);
+        d = c; c = b; b = a; a = _mm512_add_epi32(t1, t2);
+    }
+
+    s[0] = _mm512_add_epi32(s[0], a); s[1] = _mm512_add_epi32(s[1], b);
+    s[2] = _mm512_add_epi32(s[2], c); s[3] = _mm512_add_epi32(s[3], d);
+    s[4] = _mm512_add_epi32(s[4], e); s[5] = _mm512_add_epi32(s[5], f);
+    s[6] = _mm512_add_epi32(s[6], g); s[7] = _mm512_add_epi32(s[7], h);
+}
+
+__attribute__((target("avx512f")))
+static void finishAvx512(const Sha256Ctx *prefix, const uint8_t *const tails[], size_t tailLen,
+                         uint8_t digests[][SHA256_DIGEST_LEN]) {
+    uint32_t words[SIMD_MAX_BLOCKS][16][SHA256_MAX_LANES];
+    uint32_t out[8][16];
+    __m512i s[8];
+
+    int blocks = prepareLanes(prefix, tails, tailLen, 16, words);
+    for (int i = 0; i < 8; i++)
+        s[i] = _mm512_set1_epi32((int)prefix->state[i]);
+    for (int b = 0; b < blocks; b++)
+        compressAvx512(s, words[b]);
+
+    for (int i = 0; i < 8; i++)
+        _mm512_storeu_si512((void *)out[i], s[i]);
+    for (int lane = 0; lane < 16; lane++)
+        for (int i = 0; i < 8; i++)
+            storeBE32(digests[lane] + i * 4, out[i][lane]);
+}
+
+// 🔐 SHA-NI: Intel SHA extensions, 4 rounds per sha256rnds2 pair.
+// The state is kept as ABEF/CDGH as the instructions expect.
+__attribute__((target("sha,sse4.1")))
+static void compressShaNi(uint32_t state[8], const uint8_t *data, size_t blocks) {
+    const __m128i byteSwap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+    __m128i tmp = _mm_loadu_si128((const __m128i *)&state[0]);
+    __m128i state1 = _mm_loadu_si128((const __m128i *)&state[4]);
+
+    tmp = _mm_shuffle_epi32(tmp, 0xb1);                 // CDAB
+    state1 = _mm_shuffle_epi32(state1, 0x1b);           // EFGH
+    __m128i state0 = _mm_alignr_epi8(tmp, state1, 8);   // ABEF
+    state1 = _mm_blend_epi16(state1, tmp, 0xf0);        // CDGH
+
+    while (blocks--) {
+        __m128i abefSave = state0, cdghSave = state1;
+        __m128i w[4];
+
+        for (int i = 0; i < 16; i++) {
+            __m128i msg;
+            if (i < 4) {
+                w[i] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(data + i * 16)), byteSwap);
+            } else {
+                // W[i] = msg2(msg1(W[i-4], W[i-3]) + W[t-7], W[i-1])
+                __m128i wt7 = _mm_alignr_epi8(w[(i - 1) & 3], w[(i - 2) & 3], 4);
+                msg = _mm_add_epi32(_mm_sha256msg1_epu32(w[i & 3], w[(i - 3) & 3]), wt7);
+                w[i & 3] = _mm_sha256msg2_epu32(msg, w[(i - 1) & 3]);
+            }
+
+            msg = _mm_add_epi32(w[i & 3], _mm_loadu_si128((const __m128i *)&sha256K[i * 4]));
+            state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+            msg = _mm_shuffle_epi32(msg, 0x0e);
+            state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+        }
+
+        state0 = _mm_add_epi32(state0, abefSave);
+        state1 = _mm_add_epi32(state1, cdghSave);
+        data += SHA256_BLOCK_LEN;
+    }
+
+    tmp = _mm_shuffle_epi32(state0, 0x1b);              // FEBA
+    state1 = _mm_shuffle_epi32(state1, 0xb1);           // DCHG
+    state0 = _mm_blend_epi16(tmp, state1, 0xf0);        // DCBA
+    state1 = _mm_alignr_epi8(state1, tmp, 8);           // HGFE
+
+    _mm_storeu_si128((__m128i *)&state[0], state0);
+    _mm_storeu_si128((__m128i *)&state[4], state1);
+}
+
+void sha256CompressShaNi(uint32_t state[8], const uint8_t *blocks, size_t count) {
+    compressShaNi(state, blocks, count);
+}
+
+int sha256FinishAvx2(const Sha256Ctx *prefix, const uint8_t *const tails[], size_t tailLen,
+                     uint8_t digests[][SHA256_DIGEST_LEN]) {
+    if (!fitsKernel(prefix, tailLen))
+        return 0;
+    finishAvx2(prefix, tails, tailLen, digests);
+    return 1;
+}
+
+int sha256FinishAvx512(const Sha256Ctx *prefix, const uint8_t *const tails[], size_t tailLen,
+                       uint8_t digests[][SHA256_DIGEST_LEN]) {
+    if (!fitsKernel(prefix, tailLen))
+        return 0;
+    finishAvx512(prefix, tails, tailLen, digests);
+    return 1;
+}
+
+#else
+
+void sha256CompressShaNi(uint32_t state[8], const uint8_t *blocks, size_t count) {
+    sha256CompressBlocksPortable(state, blocks, count);
+}
+
+int sha256FinishAvx2(const Sha256Ctx *prefix, const uint8_t *const tails[], size_t tailLen,
+                     uint8_t digests[][SHA256_DIGEST_LEN]) {
+    (void)prefix; (void)tails; (void)tailLen; (void)digests;
+    return 0;
+}
+
+int sha256FinishAvx512(const Sha256Ctx *prefix, const uint8_t *const tails[], size_t tailLen,
+                       uint8_t digests[][SHA256_DIGEST_LEN]) {
+    (void)prefix; (void)tails; (void)tailLen; (void)digests;
+    return 0;
+}
+
+#endif
+
+// 🧪 Differential Self-Tests
+static uint32_t nextRandom(uint32_t *seed) {
+    *seed = *seed * 1103515245u + 12345u;
+    return *seed >> 16;
+}
+
+int sha256ShaNiSelfTest(void) {
+    uint8_t message[1024];
+    uint8_t expected[SHA256_DIGEST_LEN];
+    uint32_t seed = 0x5a5a1234;
+
+    for (size_t i = 0; i < sizeof(message); i++)
+        message[i] = (uint8_t)nextRandom(&seed);
+
+    for (size_t len = 0; len <= sizeof(message); len += 13) {
+        Sha256Ctx ctx;
+        uint32_t state[8];
+        uint8_t digest[SHA256_DIGEST_LEN];
+
+        // Run the portable update/final, but compress with SHA-NI
+        sha256Init(&ctx);
+        memcpy(state, ctx.state, sizeof(state));
+        size_t blocks = len / SHA256_BLOCK_LEN;
+        sha256CompressShaNi(state, message, blocks);
+        Sha256Ctx tail = ctx;
+        memcpy(tail.state, state, sizeof(state));
+        tail.length = blocks * SHA256_BLOCK_LEN;
+        sha256Update(&tail, message + blocks * SHA256_BLOCK_LEN, len - blocks * SHA256_BLOCK_LEN);
+        sha256Final(&tail, digest);
+
+        SHA256(message, len, expected);
+        if (memcmp(expected, digest, SHA256_DIGEST_LEN) != 0) {
+            fprintf(stderr, "❌ SHA-NI mismatch (%zu bytes)\n", len);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int sha256MultiSelfTest(const char *name, int lanes,
+                        int (*finish)(const Sha256Ctx *, const uint8_t *const[], size_t,
+                                      uint8_t[][SHA256_DIGEST_LEN])) {
+    uint8_t message[SHA256_MAX_LANES][512];
+    const uint8_t *tails[SHA256_MAX_LANES];
+    uint8_t digests[SHA256_MAX_LANES][SHA256_DIGEST_LEN];
+    uint8_t expected[SHA256_DIGEST_LEN];
+    uint32_t seed = 0x5eed1234;
+
+    for (size_t prefixLen = 0; prefixLen <= 200; prefixLen += 7) {
+        for (size_t tailLen = 0; tailLen <= SIMD_MAX_TAIL; tailLen += 3) {
+            // Shared prefix, different tail per lane
+            for (int lane = 0; lane < lanes; lane++) {
+                for (size_t i = 0; i < prefixLen + tailLen; i++) {
+                    uint8_t r = (uint8_t)nextRandom(&seed);
+                    message[lane][i] = i < prefixLen ? message[0][i] : r;
+                }
+                tails[lane] = message[lane] + prefixLen;
+            }
+
+            Sha256Ctx prefix;
+            sha256Init(&prefix);
+            sha256Update(&prefix, message[0], prefixLen);
+            if (!finish(&prefix, tails, tailLen, digests)) {
+                fprintf(stderr, "❌ %s rejected a %zu-byte tail\n", name, tailLen);
+                return 0;
+            }
+
+            for (int lane = 0; lane < lanes; lane++) {
+                SHA256(message[lane], prefixLen + tailLen, expected);
+                if (memcmp(expected, digests[lane], SHA256_DIGEST_LEN) != 0) {
+                    fprintf(stderr, "❌ %s lane %d mismatch (prefix %zu, tail %zu bytes)\n",
+                            name, lane, prefixLen, tailLen);
+                    return 0;
+                }
+            }
+        }
+    }
+    return 1;
+}
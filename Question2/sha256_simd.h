@@ -0,0 +1,36 @@
+#ifndef SHA256_SIMD_H
+#define SHA256_SIMD_H
+
+#include "sha256.h"
+
+#define SHA256_MAX_LANES 16
+#define SHA256_AVX2_LANES 8
+#define SHA256_AVX512_LANES 16
+
+// ⚡ x86 SHA-256 kernels
+//
+// None of these check the CPU: sha256_dispatch.c probes CPUID once and only
+// hands out kernels the machine supports. On non-x86 builds they fall back
+// to the portable code (compression) or report failure (multi-buffer).
+
+// 🔐 Single-buffer compression with Intel SHA extensions
+void sha256CompressShaNi(uint32_t state[8], const uint8_t *blocks, size_t count);
+
+// 🚀 Multi-buffer SHA-256: 8 lanes with AVX2, 16 with AVX-512.
+// Every lane continues from the same midstate `prefix` and absorbs a tail
+// of `tailLen` bytes, which is exactly the shape of a batch of nonce
+// attempts. Results are bit-identical to SHA256(prefix || tail).
+// Returns 0 (and hashes nothing) if the tail is too long for the kernel.
+int sha256FinishAvx2(const Sha256Ctx *prefix, const uint8_t *const tails[], size_t tailLen,
+                     uint8_t digests[][SHA256_DIGEST_LEN]);
+int sha256FinishAvx512(const Sha256Ctx *prefix, const uint8_t *const tails[], size_t tailLen,
+                       uint8_t digests[][SHA256_DIGEST_LEN]);
+
+// 🧪 Differential checks against OpenSSL's SHA256() over many prefix and
+// tail lengths. Return 1 when every output matches, 0 on the first mismatch.
+int sha256ShaNiSelfTest(void);
+int sha256MultiSelfTest(const char *name, int lanes,
+                        int (*finish)(const Sha256Ctx *, const uint8_t *const[], size_t,
+                                      uint8_t[][SHA256_DIGEST_LEN]));
+
+#endif
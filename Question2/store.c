@@ -0,0 +1,445 @@
+#include <stdio.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "store.h"
+
+#define STORE_FILE_HEADER_SIZE 128      // keeps index entries 64-byte aligned in the mapping
+#define STORE_FORMAT_VERSION 2          // 2: v2 headers (extraNonce, 64-bit nonce)
+#define STORE_BYTE_ORDER 0x01020304u
+#define BODY_RECORD_MAGIC 0x59444f42u   // "BODY"
+
+static const char INDEX_MAGIC[8] = "QCHNIDX";
+static const char BODY_MAGIC[8] = "QCHNDAT";
+
+// ✅ Verified height, saved in the index file header. The digest chains
+// the exact bytes of every verified block, index entry and body record:
+//   digest(0) = 0, digest(k + 1) = SHA-256(digest(k) || entry k || record k)
+// Opening recomputes it, so a checkpoint only survives if nothing below it
+// changed on disk.
+typedef struct StoreCheckpoint {
+    uint32_t count;             // blocks [0, count) passed verification
+    uint32_t minimumBits;       // ... against this minimum target
+    uint8_t digest[SHA256_DIGEST_LEN];
+} StoreCheckpoint;
+
+// 🏷️ First bytes of both files. entrySize and byteOrder make sure a file
+// written with a different struct layout is rejected instead of misread.
+// The checkpoint is only used in the index file; files written before it
+// existed have zeros there, which just means "verify everything once".
+typedef struct StoreFileHeader {
+    char magic[8];
+    uint32_t formatVersion;
+    uint32_t entrySize;
+    uint32_t byteOrder;
+    StoreCheckpoint checkpoint;
+    uint8_t reserved[STORE_FILE_HEADER_SIZE - 20 - sizeof(StoreCheckpoint)];
+} StoreFileHeader;
+
+_Static_assert(sizeof(StoreFileHeader) == STORE_FILE_HEADER_SIZE, "file header size");
+
+typedef struct BodyRecord {
+    uint32_t magic;
+    int32_t height;
+    uint32_t length;            // payload bytes after this record header
+    uint32_t transactionCount;
+} BodyRecord;
+
+#define BODY_PAYLOAD_MAX (MAX_TRANSACTIONS * (2 + MAX_DATA_LEN))
+
+static int writeAll(int fd, const void *data, size_t len, off_t offset) {
+    const uint8_t *p = data;
+    while (len > 0) {
+        ssize_t n = pwrite(fd, p, len, offset);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return 0;
+        p += n;
+        len -= n;
+        offset += n;
+    }
+    return 1;
+}
+
+static int readAll(int fd, void *data, size_t len, off_t offset) {
+    uint8_t *p = data;
+    while (len > 0) {
+        ssize_t n = pread(fd, p, len, offset);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return 0;
+        p += n;
+        len -= n;
+        offset += n;
+    }
+    return 1;
+}
+
+// 🏷️ Write the file header into a new file or check an existing one.
+// A file shorter than its header can only be a create that was cut short.
+static int prepareFile(int fd, const char magic[8], uint32_t entrySize, off_t *size,
+                       StoreFileHeader *fileHeader) {
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+        return 0;
+
+    StoreFileHeader header;
+    if (st.st_size < STORE_FILE_HEADER_SIZE) {
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, magic, sizeof(header.magic));
+        header.formatVersion = STORE_FORMAT_VERSION;
+        header.entrySize = entrySize;
+        header.byteOrder = STORE_BYTE_ORDER;
+        if (ftruncate(fd, 0) != 0 || !writeAll(fd, &header, sizeof(header), 0))
+            return 0;
+        *size = STORE_FILE_HEADER_SIZE;
+        *fileHeader = header;
+        return 1;
+    }
+
+    if (!readAll(fd, &header, sizeof(header), 0))
+        return 0;
+    if (memcmp(header.magic, magic, sizeof(header.magic)) != 0 ||
+        header.formatVersion != STORE_FORMAT_VERSION ||
+        header.entrySize != entrySize || header.byteOrder != STORE_BYTE_ORDER) {
+        errno = EINVAL;
+        return 0;
+    }
+    *size = st.st_size;
+    *fileHeader = header;
+    return 1;
+}
+
+// 📦 Body record for `body`; returns its total length
+static size_t encodeBody(const BlockBody *body, int height, uint8_t *out) {
+    BodyRecord record;
+    size_t len = sizeof(record);
+
+    for (int i = 0; i < body->transactionCount; i++) {
+        uint16_t txLen = (uint16_t)strlen(body->transactions[i]);
+        memcpy(out + len, &txLen, sizeof(txLen));
+        memcpy(out + len + sizeof(txLen), body->transactions[i], txLen);
+        len += sizeof(txLen) + txLen;
+    }
+
+    record.magic = BODY_RECORD_MAGIC;
+    record.height = height;
+    record.length = (uint32_t)(len - sizeof(record));
+    record.transactionCount = body->transactionCount;
+    memcpy(out, &record, sizeof(record));
+    return len;
+}
+
+// 📖 Read the body record of block `height` at `offset`. Anything that
+// does not fit below `limit` or does not parse is rejected. On success
+// `root` receives the merkle root of what was read and `end` the offset
+// just past the record.
+static int readBody(const ChainStore *store, int height, off_t offset, off_t limit,
+                    BlockBody *body, uint8_t root[SHA256_DIGEST_LEN], off_t *end) {
+    BodyRecord record;
+    uint8_t payload[BODY_PAYLOAD_MAX];
+
+    if (offset < STORE_FILE_HEADER_SIZE || offset + (off_t)sizeof(record) > limit)
+        return 0;
+    if (!readAll(store->bodyFd, &record, sizeof(record), offset))
+        return 0;
+    if (record.magic != BODY_RECORD_MAGIC || record.height != height ||
+        record.length > BODY_PAYLOAD_MAX || record.transactionCount > MAX_TRANSACTIONS ||
+        offset + (off_t)sizeof(record) + record.length > limit)
+        return 0;
+    if (!readAll(store->bodyFd, payload, record.length, offset + sizeof(record)))
+        return 0;
+
+    // The scratch header only collects the merkle root as it is rebuilt
+    BlockHeader scratch;
+    memset(&scratch, 0, sizeof(scratch));
+    initBlockBody(body);
+
+    size_t pos = 0;
+    for (uint32_t i = 0; i < record.transactionCount; i++) {
+        uint16_t txLen;
+        if (pos + sizeof(txLen) > record.length)
+            return 0;
+        memcpy(&txLen, payload + pos, sizeof(txLen));
+        pos += sizeof(txLen);
+        if (txLen >= MAX_DATA_LEN || pos + txLen > record.length)
+            return 0;
+
+        char text[MAX_DATA_LEN];
+        memcpy(text, payload + pos, txLen);
+        text[txLen] = '\0';
+        pos += txLen;
+        setBlockTransaction(&scratch, body, (int)i, text);
+    }
+
+    memcpy(root, scratch.merkleRoot, SHA256_DIGEST_LEN);
+    *end = offset + sizeof(record) + record.length;
+    return 1;
+}
+
+// 🧊 Chain body loader: runs the first time a mapped block's body is used
+static int loadStoredBody(void *context, int height, const BlockHeader *header, BlockBody *body) {
+    const ChainStore *store = context;
+    uint8_t root[SHA256_DIGEST_LEN];
+    off_t end;
+    if (readBody(store, height, (off_t)header->bodyOffset, store->bodyEnd, body, root, &end))
+        return 1;
+    initBlockBody(body);
+    return 0;
+}
+
+// 🩹 A tail block is complete if its entry hashes to its own hash and its
+// body record is all there and matches the merkle root
+static int tailIntact(const ChainStore *store, const BlockHeader *header, int height, off_t *end) {
+    if (header->index != height)
+        return 0;
+
+    uint8_t digest[SHA256_DIGEST_LEN];
+    calculateBlockHash(header, digest);
+    if (memcmp(digest, header->hash, SHA256_DIGEST_LEN) != 0)
+        return 0;
+
+    BlockBody *body = malloc(sizeof(BlockBody));
+    if (!body)
+        return 0;
+    int ok = readBody(store, height, (off_t)header->bodyOffset, store->bodyEnd, body, digest, end) &&
+             memcmp(digest, header->merkleRoot, SHA256_DIGEST_LEN) == 0;
+    free(body);
+    return ok;
+}
+
+void chainStoreClose(ChainStore *store) {
+    if (store->indexFd >= 0)
+        close(store->indexFd);
+    if (store->bodyFd >= 0)
+        close(store->bodyFd);
+    store->indexFd = -1;
+    store->bodyFd = -1;
+    store->count = 0;
+    store->bodyEnd = 0;
+    store->verified = 0;
+}
+
+// 🔗 Extend `digest` (the checkpoint digest of blocks [0, from)) over
+// blocks [from, to), reading their bytes back from the files
+static int digestBlocks(const ChainStore *store, int from, int to, uint8_t digest[SHA256_DIGEST_LEN]) {
+    uint8_t record[sizeof(BodyRecord) + BODY_PAYLOAD_MAX];
+    for (int height = from; height < to; height++) {
+        BlockHeader entry;
+        BodyRecord body;
+        if (!readAll(store->indexFd, &entry, sizeof(entry),
+                     STORE_FILE_HEADER_SIZE + (off_t)height * sizeof(BlockHeader)))
+            return 0;
+        off_t offset = (off_t)entry.bodyOffset;
+        if (offset < STORE_FILE_HEADER_SIZE || offset + (off_t)sizeof(body) > store->bodyEnd ||
+            !readAll(store->bodyFd, &body, sizeof(body), offset) || body.length > BODY_PAYLOAD_MAX ||
+            offset + (off_t)sizeof(body) + body.length > store->bodyEnd ||
+            !readAll(store->bodyFd, record, sizeof(body) + body.length, offset))
+            return 0;
+
+        Sha256Ctx ctx;
+        sha256Init(&ctx);
+        sha256Update(&ctx, digest, SHA256_DIGEST_LEN);
+        sha256Update(&ctx, &entry, sizeof(entry));
+        sha256Update(&ctx, record, sizeof(body) + body.length);
+        sha256Final(&ctx, digest);
+    }
+    return 1;
+}
+
+// 🎯 Is the target of `bits` easier (numerically larger) than `than`'s?
+static int minimumEasier(uint32_t bits, uint32_t than) {
+    uint8_t target[SHA256_DIGEST_LEN], limit[SHA256_DIGEST_LEN];
+    bitsToTarget(bits, target);
+    bitsToTarget(than, limit);
+    return memcmp(target, limit, SHA256_DIGEST_LEN) > 0;
+}
+
+static int writeVerified(const ChainStore *store) {
+    StoreCheckpoint checkpoint;
+    checkpoint.count = (uint32_t)store->verified;
+    checkpoint.minimumBits = store->minimumBits;
+    memcpy(checkpoint.digest, store->verifiedDigest, SHA256_DIGEST_LEN);
+    if (!writeAll(store->indexFd, &checkpoint, sizeof(checkpoint), offsetof(StoreFileHeader, checkpoint))) {
+        fprintf(stderr, "⚠️ Could not save the verified height: %s\n", strerror(errno));
+        return 0;
+    }
+    return 1;
+}
+
+int chainStoreSaveVerified(ChainStore *store, int verified) {
+    if (store->indexFd < 0)
+        return 0;
+    // Blocks that never reached the file cannot be vouched for
+    if (verified > store->count)
+        verified = store->count;
+    if (verified == store->verified)
+        return 1;
+
+    // Moving up only hashes the new blocks; moving down starts over
+    uint8_t digest[SHA256_DIGEST_LEN];
+    int from = verified > store->verified ? store->verified : 0;
+    if (from > 0)
+        memcpy(digest, store->verifiedDigest, SHA256_DIGEST_LEN);
+    else
+        memset(digest, 0, SHA256_DIGEST_LEN);
+    if (!digestBlocks(store, from, verified, digest)) {
+        fprintf(stderr, "⚠️ Could not read back blocks %d-%d to save the verified height\n", from, verified - 1);
+        return 0;
+    }
+    store->verified = verified;
+    memcpy(store->verifiedDigest, digest, SHA256_DIGEST_LEN);
+    return writeVerified(store);
+}
+
+int chainStoreOpen(ChainStore *store, Chain *chain, const char *path) {
+    char indexPath[PATH_MAX], bodyPath[PATH_MAX];
+    snprintf(indexPath, sizeof(indexPath), "%s.idx", path);
+    snprintf(bodyPath, sizeof(bodyPath), "%s.dat", path);
+
+    store->indexFd = open(indexPath, O_RDWR | O_CREAT, 0644);
+    store->bodyFd = open(bodyPath, O_RDWR | O_CREAT, 0644);
+    store->count = 0;
+    store->bodyEnd = 0;
+    store->recovered = 0;
+    store->verified = 0;
+    memset(store->verifiedDigest, 0, SHA256_DIGEST_LEN);
+    store->minimumBits = chainMinimumBits(chain);
+
+    off_t indexSize, bodySize;
+    StoreFileHeader indexHeader, bodyHeader;
+    if (store->indexFd < 0 || store->bodyFd < 0 ||
+        !prepareFile(store->indexFd, INDEX_MAGIC, sizeof(BlockHeader), &indexSize, &indexHeader) ||
+        !prepareFile(store->bodyFd, BODY_MAGIC, 0, &bodySize, &bodyHeader)) {
+        fprintf(stderr, "❌ Cannot open chain file %s: %s\n", path, strerror(errno));
+        chainStoreClose(store);
+        return 0;
+    }
+
+    off_t entries = (indexSize - STORE_FILE_HEADER_SIZE) / (off_t)sizeof(BlockHeader);
+    if (entries > INT_MAX) {
+        fprintf(stderr, "❌ Chain file %s has too many blocks\n", path);
+        chainStoreClose(store);
+        return 0;
+    }
+    int count = (int)entries;
+    store->bodyEnd = bodySize;      // limit for the tail checks below
+    off_t bodyEnd = STORE_FILE_HEADER_SIZE;
+
+    void *map = NULL;
+    size_t mapLength = STORE_FILE_HEADER_SIZE + (size_t)count * sizeof(BlockHeader);
+    BlockHeader *headers = NULL;
+    if (count > 0) {
+        map = mmap(NULL, mapLength, PROT_READ | PROT_WRITE, MAP_PRIVATE, store->indexFd, 0);
+        if (map == MAP_FAILED) {
+            fprintf(stderr, "❌ Cannot map chain file %s: %s\n", path, strerror(errno));
+            chainStoreClose(store);
+            return 0;
+        }
+        headers = (BlockHeader *)((uint8_t *)map + STORE_FILE_HEADER_SIZE);
+
+        // Only the tail can be torn; everything before it was complete
+        // when the next block was appended
+        while (count > 0 && !tailIntact(store, &headers[count - 1], count - 1, &bodyEnd))
+            count--;
+        if (count == 0) {
+            munmap(map, mapLength);
+            map = NULL;
+            bodyEnd = STORE_FILE_HEADER_SIZE;
+        }
+    }
+
+    // ✂️ Cut both files back to the last complete block
+    off_t indexEnd = STORE_FILE_HEADER_SIZE + (off_t)count * sizeof(BlockHeader);
+    if (indexSize != indexEnd || bodySize != bodyEnd) {
+        store->recovered = 1;
+        if (ftruncate(store->indexFd, indexEnd) != 0 || ftruncate(store->bodyFd, bodyEnd) != 0)
+            fprintf(stderr, "⚠️ Could not trim the torn end of %s: %s\n", path, strerror(errno));
+    }
+    store->count = count;
+    store->bodyEnd = bodyEnd;
+
+    // ✅ The checkpoint is kept only if the blocks it covers are still
+    // there, byte for byte. A trimmed tail or any edit below the verified
+    // height means verifying from the start again.
+    StoreCheckpoint *saved = &indexHeader.checkpoint;
+    if (saved->count > 0 && minimumEasier(saved->minimumBits, store->minimumBits)) {
+        fprintf(stderr, "⚠️ %s was verified with an easier minimum target; it will be verified from block 0\n", path);
+        writeVerified(store);
+    } else if (saved->count > 0) {
+        uint8_t digest[SHA256_DIGEST_LEN] = {0};
+        if (saved->count <= (uint32_t)count && digestBlocks(store, 0, (int)saved->count, digest) &&
+            memcmp(digest, saved->digest, SHA256_DIGEST_LEN) == 0) {
+            store->verified = (int)saved->count;
+            memcpy(store->verifiedDigest, digest, SHA256_DIGEST_LEN);
+        } else {
+            if (!store->recovered)
+                fprintf(stderr, "⚠️ %s changed since it was last verified; it will be verified from block 0\n", path);
+            writeVerified(store);
+        }
+    }
+
+    if (count > 0) {
+        BlockBody **bodies = calloc(count, sizeof(BlockBody *));
+        if (!bodies) {
+            fprintf(stderr, "❌ Out of memory opening %d blocks\n", count);
+            munmap(map, mapLength);
+            chainStoreClose(store);
+            return 0;
+        }
+        chain->headers = headers;
+        chain->bodies = bodies;
+        chain->count = count;
+        chain->capacity = count;
+        chain->verified = store->verified;
+        chain->headerMap = map;
+        chain->headerMapLength = mapLength;
+    }
+    chain->loadBody = loadStoredBody;
+    chain->loadContext = store;
+    return 1;
+}
+
+int chainStoreAppend(ChainStore *store, Chain *chain, int height) {
+    if (store->indexFd < 0)
+        return 0;
+    if (height != store->count) {
+        fprintf(stderr, "⚠️ Block %d is not the next block of the chain file (%d)\n", height, store->count);
+        return 0;
+    }
+
+    uint8_t record[sizeof(BodyRecord) + BODY_PAYLOAD_MAX];
+    size_t length = encodeBody(chainBody(chain, height), height, record);
+
+    // bodyOffset is not part of the block hash, so this is not an edit
+    BlockHeader *header = &chain->headers[height];
+    header->bodyOffset = (uint64_t)store->bodyEnd;
+
+    // Body first: an index entry never points at a body that is not there
+    if (!writeAll(store->bodyFd, record, length, store->bodyEnd) ||
+        !writeAll(store->indexFd, header, sizeof(BlockHeader),
+                  STORE_FILE_HEADER_SIZE + (off_t)height * sizeof(BlockHeader))) {
+        fprintf(stderr, "❌ Could not write block %d to the chain file: %s\n", height, strerror(errno));
+        return 0;
+    }
+
+    store->bodyEnd += length;
+    store->count++;
+    return 1;
+}
+
+const char *parseChainPath(int argc, char *argv[], const char *fallback) {
+    for (int i = 1; i < argc - 1; i++)
+        if (strcmp(argv[i], "--chain") == 0)
+            return argv[i + 1];
+    return fallback;
+}
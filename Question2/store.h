@@ -0,0 +1,73 @@
+#ifndef STORE_H
+#define STORE_H
+
+#include <sys/types.h>
+
+#include "chain.h"
+
+// 💾 Append-only Chain File
+//
+// A chain is kept in two files next to each other:
+//
+//   <path>.idx  128-byte file header, then one BlockHeader per height,
+//               byte for byte as it sits in memory
+//   <path>.dat  128-byte file header, then one body record per height:
+//               { magic, height, payload length, transaction count }
+//               followed by each transaction as { uint16 length, text }
+//
+// Each header's bodyOffset points at its body record. Because index
+// entries have the in-memory layout, opening a chain maps the index and
+// uses it as the header array directly: nothing is parsed, and bodies are
+// read only when a block's transactions are first needed.
+//
+// Blocks are appended body first, then header. A crash can leave a partial
+// index entry, an entry whose body never made it, or a body without an
+// entry; chainStoreOpen checks the tail for all three and cuts the files
+// back to the last complete block.
+//
+// The index header also keeps the chain's verified height, with a digest
+// of the exact bytes of the blocks below it. A reopened chain whose digest
+// still matches starts with its checkpoint (chain->verified) where it was
+// left, so the next verification only checks new blocks. If anything
+// below the checkpoint changed on disk, or a torn tail was cut, the
+// checkpoint goes back to 0 and the whole chain is verified again.
+//
+// The checkpoint also records the minimum target it was verified under.
+// Tasks 2-4 share one chain file but not one minimum, so a program whose
+// minimum is harder than the saved one (Task 3 after Task 4) ignores the
+// checkpoint and verifies everything against its own rule.
+typedef struct ChainStore {
+    int indexFd;            // -1 when no file is open
+    int bodyFd;
+    int count;              // blocks on disk
+    off_t bodyEnd;          // where the next body record goes
+    int recovered;          // incomplete blocks dropped from the tail at open
+    int verified;           // verified height saved in the index header
+    uint8_t verifiedDigest[SHA256_DIGEST_LEN];  // digest of blocks [0, verified)
+    uint32_t minimumBits;   // chain->minimumBits at open, saved with the checkpoint
+} ChainStore;
+
+// 📂 Open (or create) the chain file at `path` and load it into `chain`,
+// which must be empty and already have its minimumBits set. The store
+// must stay open while the chain is used, since bodies are read from it
+// on demand. Returns 0 on error, leaving the store closed and the chain
+// empty.
+int chainStoreOpen(ChainStore *store, Chain *chain, const char *path);
+
+// ➕ Write block `height` (the next one the file does not have yet). Call
+// it before chainCommit and only commit on success, so the chain never
+// holds a block the file lacks. Nothing moves until both writes succeed,
+// so after a failure the same height can simply be written again.
+int chainStoreAppend(ChainStore *store, Chain *chain, int height);
+
+// ✅ Save chain->verified after a verification. Heights above the blocks
+// on disk are clamped. Only blocks above the previous checkpoint are read
+// back and hashed, unless the height went down. Returns 0 on failure.
+int chainStoreSaveVerified(ChainStore *store, int verified);
+
+void chainStoreClose(ChainStore *store);
+
+// ⚙️ Read "--chain <path>" from the command line (default: `fallback`)
+const char *parseChainPath(int argc, char *argv[], const char *fallback);
+
+#endif
@@ -4,6 +4,8 @@
 #include <time.h>
 #include <openssl/sha.h>
 
+#include "batch.h"
+
 #define MAX_BLOCKS 100
 #define MAX_TRANSACTIONS 5
 #define MAX_DATA_LEN 256
@@ -89,6 +91,26 @@ void printBlockchain() {
     }
 }
 
+// === ➕ Append a Block of Transactions ===
+int addBlock(char transactions[][MAX_DATA_LEN], int txnCount) {
+    if (blockCount >= MAX_BLOCKS) {
+        printf("❌ Blockchain is full (%d blocks).\n", MAX_BLOCKS);
+        return 0;
+    }
+
+    char prevHash[HASH_SIZE] = "0";
+    if (blockCount > 0) {
+        strcpy(prevHash, blockchain[blockCount - 1].hash);
+    }
+
+    Block newBlock = createBlock(prevHash, transactions, txnCount);
+    blockchain[blockCount++] = newBlock;
+
+    if (!batchMode)
+        printf("✅ Block %d added to blockchain!\n", newBlock.index);
+    return 1;
+}
+
 // === 🧾 Add Block via User Input ===
 void addBlockFromInput() {
     char transactions[MAX_TRANSACTIONS][MAX_DATA_LEN];
@@ -109,15 +131,7 @@ void addBlockFromInput() {
         transactions[i][strcspn(transactions[i], "\n")] = 0; // remove newline
     }
 
-    char prevHash[HASH_SIZE] = "0";
-    if (blockCount > 0) {
-        strcpy(prevHash, blockchain[blockCount - 1].hash);
-    }
-
-    Block newBlock = createBlock(prevHash, transactions, txnCount);
-    blockchain[blockCount++] = newBlock;
-
-    printf("✅ Block %d added to blockchain!\n", newBlock.index);
+    addBlock(transactions, txnCount);
 }
 
 // === 📋 Main Menu ===
@@ -149,8 +163,13 @@ void showMenu() {
 }
 
 // === 🚀 Main ===
-int main() {
+int main(int argc, char *argv[]) {
     printf("🔐 Simple Blockchain Simulator (Account/Transaction Model)\n");
-    showMenu();
+
+    const char *batchPath = parseBatchPath(argc, argv);
+    if (batchPath)
+        runBatch(batchPath, addBlock, MAX_TRANSACTIONS);
+    else
+        showMenu();
     return 0;
 }
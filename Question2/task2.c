@@ -4,84 +4,86 @@
 #include <time.h>
 #include <unistd.h>     // ✅ For sleep()
 
-#include <openssl/sha.h>
+#include "block.h"
+#include "chain.h"
+#include "store.h"
+#include "miner.h"
+#include "batch.h"
 
-#define MAX_BLOCKS 100
-#define MAX_TRANSACTIONS 10
-#define MAX_DATA_LEN 256
-#define HASH_SIZE 65
 #define DIFFICULTY 4
 
-typedef struct Block {
-    int index;
-    time_t timestamp;
-    char transactions[MAX_TRANSACTIONS][MAX_DATA_LEN];
-    int transactionCount;
-    char previousHash[HASH_SIZE];
-    char hash[HASH_SIZE];
-    int nonce;
-} Block;
-
-Block blockchain[MAX_BLOCKS];
-int blockCount = 0;
-
-// 🎯 SHA-256 Hash Function
-void calculateSHA256(char *input, char output[HASH_SIZE]) {
-    unsigned char hash[SHA256_DIGEST_LENGTH];
-    SHA256((unsigned char *)input, strlen(input), hash);
-    for (int i = 0; i < SHA256_DIGEST_LENGTH; i++)
-        sprintf(output + (i * 2), "%02x", hash[i]);
-    output[64] = '\0';
-}
-
-// 🔧 Compute Hash for a Block
-void computeBlockHash(Block *block) {
-    char buffer[2048] = {0};
-    char txConcat[MAX_TRANSACTIONS * MAX_DATA_LEN] = {0};
-    for (int i = 0; i < block->transactionCount; i++)
-        strcat(txConcat, block->transactions[i]);
-
-    snprintf(buffer, sizeof(buffer), "%d%ld%s%s%d",
-             block->index, block->timestamp, txConcat, block->previousHash, block->nonce);
-
-    calculateSHA256(buffer, block->hash);
-}
+Chain blockchain;   // zero-initialised == chainInit()
+ChainStore chainFile;   // where committed blocks are appended
 
 // ⛏️ Proof-of-Work Mining
-void mineBlock(Block *block) {
-    char target[DIFFICULTY + 1];
-    memset(target, '0', DIFFICULTY);
-    target[DIFFICULTY] = '\0';
+void mineBlock(BlockHeader *block) {
+    MiningResult result;
 
-    printf("🔍 Mining block %d...\n", block->index);
+    if (!batchMode)
+        printf("🔍 Mining block %d with %d thread(s)...\n", block->index, miningThreads);
 
-    do {
-        block->nonce++;
-        computeBlockHash(block);
-    } while (strncmp(block->hash, target, DIFFICULTY) != 0);
+    mineBlockParallel(block, miningThreads, NULL, &result);
+    block->nonce = result.nonce;
+    block->extraNonce = result.extraNonce;
+    block->timestamp = result.timestamp;
+    memcpy(block->hash, result.hash, SHA256_DIGEST_LEN);
+
+    // 🔕 Batch runs report totals at the end instead
+    if (batchMode)
+        return;
 
     sleep(2); // ⏱️ Delay to simulate mining effort
 
-    printf("✅ Block mined! Nonce: %d\n", block->nonce);
-    printf("🔑 Hash: %s\n", block->hash);
+    printf("✅ Block mined! Nonce: %llu (extra nonce %u)\n",
+           (unsigned long long)block->nonce, block->extraNonce);
+    char hex[HASH_SIZE];
+    hashToHex(block->hash, hex);
+    printf("🔑 Hash: %s\n", hex);
 }
 
 // 📦 Create a New Block
-Block createBlock(char *prevHash, char transactions[][MAX_DATA_LEN], int txnCount) {
-    Block block;
-    block.index = blockCount;
-    block.timestamp = time(NULL);
-    block.transactionCount = txnCount;
-    block.nonce = 0;
-    strcpy(block.previousHash, prevHash);
-
+BlockHeader *createBlock(char transactions[][MAX_DATA_LEN], int txnCount) {
+    // Built and mined in the chain's next slot; the caller commits it
+    int height = chainPrepare(&blockchain);
+    if (height < 0)
+        return NULL;
+
+    BlockHeader *block = chainEditHeader(&blockchain, height);
+    BlockBody *body = chainEditBody(&blockchain, height);
+    block->version = BLOCK_VERSION;
+    block->index = height;
+    block->timestamp = time(NULL);
+    block->extraNonce = 0;
+    block->nonce = 0;
+    block->bits = difficultyToBits(DIFFICULTY);
+    chainTipHash(&blockchain, block->previousHash);
+
+    // Merkle tree is built once here, one O(log n) path per transaction
     for (int i = 0; i < txnCount; i++)
-        strcpy(block.transactions[i], transactions[i]);
+        setBlockTransaction(block, body, i, transactions[i]);
 
-    mineBlock(&block);
+    mineBlock(block);
     return block;
 }
 
+// ➕ Mine a block of transactions and append it to the chain
+int addBlock(char transactions[][MAX_DATA_LEN], int txnCount) {
+    BlockHeader *newBlock = createBlock(transactions, txnCount);
+    if (!newBlock)
+        return 0;
+    // Saved before it is committed: a block the chain file could not take
+    // is not added, and its slot is reused by the next block
+    if (chainFile.indexFd >= 0 && !chainStoreAppend(&chainFile, &blockchain, newBlock->index)) {
+        printf("❌ Block %d could not be saved to the chain file, so it was not added.\n", newBlock->index);
+        return 0;
+    }
+    chainCommit(&blockchain);
+
+    if (!batchMode)
+        printf("🧱 Block %d successfully added to the blockchain!\n", newBlock->index);
+    return 1;
+}
+
 // 🧾 Add Block with User Transactions
 void addBlockFromInput() {
     int txnCount;
@@ -103,36 +105,33 @@ void addBlockFromInput() {
         transactions[i][strcspn(transactions[i], "\n")] = '\0'; // Remove newline
     }
 
-    char prevHash[HASH_SIZE] = "0";
-    if (blockCount > 0)
-        strcpy(prevHash, blockchain[blockCount - 1].hash);
-
-    Block newBlock = createBlock(prevHash, transactions, txnCount);
-    blockchain[blockCount++] = newBlock;
-
-    printf("🧱 Block %d successfully added to the blockchain!\n", newBlock.index);
+    addBlock(transactions, txnCount);
 }
 
 // 📜 Display the Entire Blockchain
 void printBlockchain() {
-    if (blockCount == 0) {
+    if (blockchain.count == 0) {
         printf("\n🚫 Blockchain is empty.\n");
         return;
     }
 
     printf("\n🧬 ====== Blockchain ======\n");
 
-    for (int i = 0; i < blockCount; i++) {
-        Block *b = &blockchain[i];
+    for (int i = 0; i < blockchain.count; i++) {
+        const BlockHeader *b = chainHeader(&blockchain, i);
+        const BlockBody *body = chainBody(&blockchain, i);
+        char prevHex[HASH_SIZE], hashHex[HASH_SIZE];
+        hashToHex(b->previousHash, prevHex);
+        hashToHex(b->hash, hashHex);
         printf("\n🔗 ── Block %d ───────────────────────────\n", b->index);
         printf("🕒 Timestamp      : %s", ctime(&b->timestamp));
         printf("💬 Transactions   :\n");
-        for (int j = 0; j < b->transactionCount; j++) {
-            printf("   • %s\n", b->transactions[j]);
+        for (int j = 0; j < body->transactionCount; j++) {
+            printf("   • %s\n", body->transactions[j]);
         }
-        printf("🔗 Previous Hash  : %.20s...\n", b->previousHash);
-        printf("🧮 Nonce          : %d\n", b->nonce);
-        printf("🔐 Hash           : %.20s...\n", b->hash);
+        printf("🔗 Previous Hash  : %.20s...\n", prevHex);
+        printf("🧮 Nonce          : %llu (extra %u)\n", (unsigned long long)b->nonce, b->extraNonce);
+        printf("🔐 Hash           : %.20s...\n", hashHex);
     }
 
     printf("\n=========================== 🧬\n");
@@ -170,9 +169,27 @@ void showMenu() {
 }
 
 // 🚀 Main Entry
-int main() {
+int main(int argc, char *argv[]) {
+    miningThreads = parseMiningThreads(argc, argv);
+    selectHashBackend(argc, argv);
+
     printf("🔐 Welcome to the Blockchain Simulator with Proof-of-Work\n");
     printf("⚙️  Mining difficulty set to %d leading zeros\n", DIFFICULTY);
-    showMenu();
+    printf("🧵 Mining threads: %d (%s hashing)\n", miningThreads, sha256BackendName(sha256ActiveBackend()));
+
+    const char *chainPath = parseChainPath(argc, argv, "blockchain");
+    if (chainStoreOpen(&chainFile, &blockchain, chainPath)) {
+        printf("💾 Chain file: %s (%d block(s) loaded)\n", chainPath, blockchain.count);
+        if (chainFile.recovered)
+            printf("⚠️ Dropped an incomplete block from the end of the chain file.\n");
+    }
+
+    const char *batchPath = parseBatchPath(argc, argv);
+    if (batchPath)
+        runBatch(batchPath, addBlock, MAX_TRANSACTIONS);
+    else
+        showMenu();
+    chainFree(&blockchain);
+    chainStoreClose(&chainFile);
     return 0;
 }
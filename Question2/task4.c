@@ -3,87 +3,88 @@
 #include <string.h>
 #include <time.h>
 #include <unistd.h>
-#include <openssl/sha.h>
 
-#define MAX_BLOCKS 100
-#define MAX_TRANSACTIONS 10
-#define MAX_DATA_LEN 256
-#define HASH_SIZE 65
+#include "block.h"
+#include "chain.h"
+#include "store.h"
+#include "miner.h"
+#include "batch.h"
+#include "verify.h"
 
-typedef struct Block {
-    int index;
-    time_t timestamp;
-    char transactions[MAX_TRANSACTIONS][MAX_DATA_LEN];
-    int transactionCount;
-    char previousHash[HASH_SIZE];
-    char hash[HASH_SIZE];
-    int nonce;
-} Block;
-
-Block blockchain[MAX_BLOCKS];
-int blockCount = 0;
-int difficulty = 4;  // Default difficulty
-
-// 🧮 SHA-256 Hash
-void calculateSHA256(char *input, char output[HASH_SIZE]) {
-    unsigned char hash[SHA256_DIGEST_LENGTH];
-    SHA256((unsigned char *)input, strlen(input), hash);
-    for (int i = 0; i < SHA256_DIGEST_LENGTH; i++)
-        sprintf(output + (i * 2), "%02x", hash[i]);
-    output[64] = '\0';
-}
-
-// 🔧 Hash Block
-void computeBlockHash(Block *block) {
-    char buffer[2048] = {0};
-    char txConcat[MAX_TRANSACTIONS * MAX_DATA_LEN] = {0};
-    for (int i = 0; i < block->transactionCount; i++)
-        strcat(txConcat, block->transactions[i]);
-
-    snprintf(buffer, sizeof(buffer), "%d%ld%s%s%d",
-             block->index, block->timestamp, txConcat, block->previousHash, block->nonce);
-
-    calculateSHA256(buffer, block->hash);
-}
+Chain blockchain;   // zero-initialised == chainInit()
+ChainStore chainFile;   // where committed blocks are appended
+double difficulty = 4;  // Default difficulty (leading hex zeros, fractions allowed)
 
 // ⛏️ Mine Block
-void mineBlock(Block *block) {
-    char target[HASH_SIZE];
-    memset(target, '0', difficulty);
-    target[difficulty] = '\0';
+void mineBlock(BlockHeader *block) {
+    MiningResult result;
 
-    printf("🔍 Mining block %d with difficulty %d...\n", block->index, difficulty);
+    if (!batchMode)
+        printf("🔍 Mining block %d with difficulty %.2f on %d thread(s)...\n",
+               block->index, bitsToDifficulty(block->bits), miningThreads);
 
-    clock_t start = clock();
-    do {
-        block->nonce++;
-        computeBlockHash(block);
-    } while (strncmp(block->hash, target, difficulty) != 0);
-    clock_t end = clock();
+    mineBlockParallel(block, miningThreads, NULL, &result);
+    block->nonce = result.nonce;
+    block->extraNonce = result.extraNonce;
+    block->timestamp = result.timestamp;
+    memcpy(block->hash, result.hash, SHA256_DIGEST_LEN);
 
-    double timeTaken = (double)(end - start) / CLOCKS_PER_SEC;
+    // 🔕 Batch runs report totals at the end instead
+    if (batchMode)
+        return;
 
-    printf("✅ Block mined! Nonce: %d\n", block->nonce);
-    printf("🔑 Hash: %s\n", block->hash);
-    printf("⏱️ Mining Time: %.2f seconds\n", timeTaken);
+    printf("✅ Block mined! Nonce: %llu (extra nonce %u)\n",
+           (unsigned long long)block->nonce, block->extraNonce);
+    char hex[HASH_SIZE];
+    hashToHex(block->hash, hex);
+    printf("🔑 Hash: %s\n", hex);
+    printf("⏱️ Mining Time: %.2f seconds (%.0f hashes/sec)\n", result.seconds,
+           result.seconds > 0 ? result.attempts / result.seconds : 0.0);
 }
 
 // 📦 Create Block
-Block createBlock(char *prevHash, char transactions[][MAX_DATA_LEN], int txnCount) {
-    Block block;
-    block.index = blockCount;
-    block.timestamp = time(NULL);
-    block.transactionCount = txnCount;
-    block.nonce = 0;
-    strcpy(block.previousHash, prevHash);
-
+BlockHeader *createBlock(char transactions[][MAX_DATA_LEN], int txnCount) {
+    // Built and mined in the chain's next slot; the caller commits it
+    int height = chainPrepare(&blockchain);
+    if (height < 0)
+        return NULL;
+
+    BlockHeader *block = chainEditHeader(&blockchain, height);
+    BlockBody *body = chainEditBody(&blockchain, height);
+    block->version = BLOCK_VERSION;
+    block->index = height;
+    block->timestamp = time(NULL);
+    block->extraNonce = 0;
+    block->nonce = 0;
+    block->bits = difficultyToBits(difficulty);
+    chainTipHash(&blockchain, block->previousHash);
+
+    // Merkle tree is built once here, one O(log n) path per transaction
     for (int i = 0; i < txnCount; i++)
-        strcpy(block.transactions[i], transactions[i]);
+        setBlockTransaction(block, body, i, transactions[i]);
 
-    mineBlock(&block);
+    mineBlock(block);
     return block;
 }
 
+// ➕ Mine a block of transactions and append it to the chain
+int addBlock(char transactions[][MAX_DATA_LEN], int txnCount) {
+    BlockHeader *newBlock = createBlock(transactions, txnCount);
+    if (!newBlock)
+        return 0;
+    // Saved before it is committed: a block the chain file could not take
+    // is not added, and its slot is reused by the next block
+    if (chainFile.indexFd >= 0 && !chainStoreAppend(&chainFile, &blockchain, newBlock->index)) {
+        printf("❌ Block %d could not be saved to the chain file, so it was not added.\n", newBlock->index);
+        return 0;
+    }
+    chainCommit(&blockchain);
+
+    if (!batchMode)
+        printf("🧱 Block %d added to blockchain!\n", newBlock->index);
+    return 1;
+}
+
 // 🧾 Add Block from User Input
 void addBlockFromInput() {
     int txnCount;
@@ -105,35 +106,32 @@ void addBlockFromInput() {
         transactions[i][strcspn(transactions[i], "\n")] = '\0';
     }
 
-    char prevHash[HASH_SIZE] = "0";
-    if (blockCount > 0)
-        strcpy(prevHash, blockchain[blockCount - 1].hash);
-
-    Block newBlock = createBlock(prevHash, transactions, txnCount);
-    blockchain[blockCount++] = newBlock;
-
-    printf("🧱 Block %d added to blockchain!\n", newBlock.index);
+    addBlock(transactions, txnCount);
 }
 
 // 🧬 View Blockchain
 void printBlockchain() {
-    if (blockCount == 0) {
+    if (blockchain.count == 0) {
         printf("\n🚫 Blockchain is empty.\n");
         return;
     }
 
     printf("\n🧬 ====== Blockchain ======\n");
 
-    for (int i = 0; i < blockCount; i++) {
-        Block *b = &blockchain[i];
+    for (int i = 0; i < blockchain.count; i++) {
+        const BlockHeader *b = chainHeader(&blockchain, i);
+        const BlockBody *body = chainBody(&blockchain, i);
+        char prevHex[HASH_SIZE], hashHex[HASH_SIZE];
+        hashToHex(b->previousHash, prevHex);
+        hashToHex(b->hash, hashHex);
         printf("\n🔗 ── Block %d ───────────────────────────\n", b->index);
         printf("🕒 Timestamp      : %s", ctime(&b->timestamp));
         printf("💬 Transactions   :\n");
-        for (int j = 0; j < b->transactionCount; j++)
-            printf("   • %s\n", b->transactions[j]);
-        printf("🔗 Previous Hash  : %.20s...\n", b->previousHash);
-        printf("🧮 Nonce          : %d\n", b->nonce);
-        printf("🔐 Hash           : %.20s...\n", b->hash);
+        for (int j = 0; j < body->transactionCount; j++)
+            printf("   • %s\n", body->transactions[j]);
+        printf("🔗 Previous Hash  : %.20s...\n", prevHex);
+        printf("🧮 Nonce          : %llu (extra %u)\n", (unsigned long long)b->nonce, b->extraNonce);
+        printf("🔐 Hash           : %.20s...\n", hashHex);
     }
 
     printf("\n=========================== 🧬\n");
@@ -141,27 +139,16 @@ void printBlockchain() {
 
 // ✅ Verify Blockchain
 int verifyBlockchain() {
-    for (int i = 1; i < blockCount; i++) {
-        char expectedHash[HASH_SIZE];
-        computeBlockHash(&blockchain[i - 1]);
-        strcpy(expectedHash, blockchain[i - 1].hash);
-
-        if (strcmp(expectedHash, blockchain[i].previousHash) != 0) {
-            printf("❌ Invalid previous hash at block %d\n", i);
-            return 0;
-        }
-
-        computeBlockHash(&blockchain[i]);
-        char target[HASH_SIZE];
-        memset(target, '0', difficulty);
-        target[difficulty] = '\0';
-
-        if (strncmp(blockchain[i].hash, target, difficulty) != 0) {
-            printf("❌ Invalid hash at block %d\n", i);
-            return 0;
-        }
-    }
-    return 1;
+    // Only blocks above the verified checkpoint are rehashed (in parallel)
+    ChainVerifyResult check;
+    int valid = verifyChainIncremental(&blockchain, miningThreads, &check);
+    chainStoreSaveVerified(&chainFile, blockchain.verified);
+    printf("🧵 Checked %d block(s) in %.3f seconds on %d thread(s)\n",
+           check.checked, check.seconds, miningThreads);
+
+    if (!valid)
+        printf("❌ Block %d: %s\n", check.height, chainFaultMessage(check.fault));
+    return valid;
 }
 
 // 🧪 Benchmark Mode
@@ -174,10 +161,7 @@ void benchmarkDifficulty() {
     for (int d = 1; d <= maxDifficulty; d++) {
         difficulty = d;
         char txs[1][MAX_DATA_LEN] = {"benchmark -> test: 1"};
-        char prevHash[HASH_SIZE] = "0";
-        if (blockCount > 0)
-            strcpy(prevHash, blockchain[blockCount - 1].hash);
-        Block testBlock = createBlock(prevHash, txs, 1);
+        createBlock(txs, 1);   // mined but not committed to the chain
         printf("🧱 Benchmark block at difficulty %d complete.\n", d);
         printf("---------------------------------------------\n");
     }
@@ -185,10 +169,77 @@ void benchmarkDifficulty() {
 
 // ⚙️ Set Mining Difficulty
 void adjustDifficulty() {
-    printf("🎯 Enter new mining difficulty: ");
-    scanf("%d", &difficulty);
+    printf("🎯 Enter new mining difficulty (leading zeros, e.g. 4 or 4.5): ");
+    scanf("%lf", &difficulty);
     getchar();
-    printf("✅ Difficulty set to %d leading zeros.\n", difficulty);
+    // Verification rejects blocks easier than the chain minimum
+    if (difficulty < CHAIN_MIN_DIFFICULTY) {
+        difficulty = CHAIN_MIN_DIFFICULTY;
+        printf("⚠️ Difficulty raised to the minimum of %.2f.\n", difficulty);
+    }
+    printf("✅ Difficulty set to %.2f leading zeros (target bits 0x%08x).\n",
+           difficulty, difficultyToBits(difficulty));
+}
+
+// 🧾 Audit a Transaction with a Merkle Proof
+void auditTransaction() {
+    int blockIndex, txIndex;
+
+    printf("🔢 Enter block index: ");
+    scanf("%d", &blockIndex);
+    getchar();
+    if (blockIndex < 0 || blockIndex >= blockchain.count) {
+        printf("❌ Invalid block index.\n");
+        return;
+    }
+
+    const BlockHeader *b = chainHeader(&blockchain, blockIndex);
+    const BlockBody *body = chainBody(&blockchain, blockIndex);
+    printf("🔢 Enter transaction number (1-%d): ", body->transactionCount);
+    scanf("%d", &txIndex);
+    getchar();
+
+    MerkleProof proof;
+    if (!proveTransaction(body, txIndex - 1, &proof)) {
+        printf("❌ Invalid transaction number.\n");
+        return;
+    }
+
+    printf("🧾 Merkle proof for \"%s\" (%d hashes):\n", body->transactions[txIndex - 1], proof.length);
+    for (int i = 0; i < proof.length; i++) {
+        char hex[HASH_SIZE];
+        hashToHex(proof.siblings[i], hex);
+        printf("   %d. %.20s...\n", i + 1, hex);
+    }
+
+    // An auditor only needs the transaction, the proof and the header's root
+    uint8_t leaf[SHA256_DIGEST_LEN];
+    merkleLeafHash(body->transactions[txIndex - 1], leaf);
+    if (merkleVerify(leaf, &proof, b->merkleRoot))
+        printf("✅ Transaction is included in block %d.\n", b->index);
+    else
+        printf("❌ Proof does not match the block's merkle root.\n");
+}
+
+// ✏️ Edit a Transaction in Place (tamper test)
+void editTransaction() {
+    int blockIndex, txIndex;
+    char transaction[MAX_DATA_LEN];
+
+    printf("🔢 Enter block index: ");
+    scanf("%d", &blockIndex);
+    printf("🔢 Enter transaction number: ");
+    scanf("%d", &txIndex);
+    getchar();
+    printf("✍️ New transaction text: ");
+    fgets(transaction, MAX_DATA_LEN, stdin);
+    transaction[strcspn(transaction, "\n")] = '\0';
+
+    if (!chainReplaceTransaction(&blockchain, blockIndex, txIndex - 1, transaction)) {
+        printf("❌ Invalid block index or transaction number.\n");
+        return;
+    }
+    printf("⚠️ Block %d edited; it will be re-verified from height %d.\n", blockIndex, blockchain.verified);
 }
 
 // 📋 Menu
@@ -203,7 +254,9 @@ void showMenu() {
         printf("3️⃣  Verify Blockchain\n");
         printf("4️⃣  Adjust Difficulty\n");
         printf("5️⃣  Benchmark Difficulty\n");
-        printf("6️⃣  Exit\n");
+        printf("6️⃣  Audit Transaction (Merkle Proof)\n");
+        printf("7️⃣  Edit Transaction (Tamper Test)\n");
+        printf("8️⃣  Exit\n");
         printf("=============================\n");
         printf("Select an option: ");
         scanf("%d", &choice);
@@ -220,16 +273,36 @@ void showMenu() {
                 break;
             case 4: adjustDifficulty(); break;
             case 5: benchmarkDifficulty(); break;
-            case 6: printf("👋 Exiting. Goodbye!\n"); break;
+            case 6: auditTransaction(); break;
+            case 7: editTransaction(); break;
+            case 8: printf("👋 Exiting. Goodbye!\n"); break;
             default: printf("❌ Invalid option.\n");
         }
-    } while (choice != 6);
+    } while (choice != 8);
 }
 
 // 🚀 Main
-int main() {
+int main(int argc, char *argv[]) {
+    miningThreads = parseMiningThreads(argc, argv);
+    selectHashBackend(argc, argv);
+
     printf("🔐 Welcome to the Blockchain Simulator with Proof-of-Work\n");
-    printf("⚙️  Mining difficulty set to %d leading zeros\n", difficulty);
-    showMenu();
+    printf("⚙️  Mining difficulty set to %.2f leading zeros\n", difficulty);
+    printf("🧵 Mining threads: %d (%s hashing)\n", miningThreads, sha256BackendName(sha256ActiveBackend()));
+
+    const char *chainPath = parseChainPath(argc, argv, "blockchain");
+    if (chainStoreOpen(&chainFile, &blockchain, chainPath)) {
+        printf("💾 Chain file: %s (%d block(s) loaded)\n", chainPath, blockchain.count);
+        if (chainFile.recovered)
+            printf("⚠️ Dropped an incomplete block from the end of the chain file.\n");
+    }
+
+    const char *batchPath = parseBatchPath(argc, argv);
+    if (batchPath)
+        runBatch(batchPath, addBlock, MAX_TRANSACTIONS);
+    else
+        showMenu();
+    chainFree(&blockchain);
+    chainStoreClose(&chainFile);
     return 0;
 }
@@ -0,0 +1,195 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+#include "verify.h"
+
+#define VERIFY_CHUNK 32     // heights claimed per trip to the shared counter
+
+// 🧠 Shared state for one verification run
+typedef struct VerifyJob {
+    const Chain *chain;
+    uint8_t minimumTarget[SHA256_DIGEST_LEN];   // easiest target a block may declare
+    int end;
+    atomic_int next;        // next unclaimed height
+    atomic_int lowestBad;   // lowest failing height so far (end if none)
+    atomic_int checked;
+    ChainFault *faults;     // fault per height, indexed from `from`
+    int from;
+} VerifyJob;
+
+const char *chainFaultMessage(ChainFault fault) {
+    switch (fault) {
+        case CHAIN_OK:         return "valid";
+        case CHAIN_BAD_MERKLE: return "transactions do not match merkle root";
+        case CHAIN_BAD_HASH:   return "invalid hash";
+        case CHAIN_BAD_TARGET: return "hash does not meet target";
+        case CHAIN_EASY_TARGET: return "target easier than the chain minimum";
+        case CHAIN_BAD_INDEX:  return "index does not match height";
+        case CHAIN_BAD_LINK:   return "invalid previous hash";
+    }
+    return "unknown";
+}
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// 🔍 Everything that can be checked without looking at other blocks
+static ChainFault checkBlock(const VerifyJob *job, int height, BlockBody *scratch) {
+    const BlockHeader *block = chainHeader(job->chain, height);
+    uint8_t digest[SHA256_DIGEST_LEN];
+
+    if (block->index != height)
+        return CHAIN_BAD_INDEX;
+
+    // Both targets are big-endian, so memcmp orders them
+    uint8_t target[SHA256_DIGEST_LEN];
+    bitsToTarget(block->bits, target);
+    if (memcmp(target, job->minimumTarget, SHA256_DIGEST_LEN) > 0)
+        return CHAIN_EASY_TARGET;
+
+    const BlockBody *body = chainReadBody(job->chain, height, scratch);
+
+    computeMerkleRoot(body, digest);
+    if (memcmp(block->merkleRoot, digest, SHA256_DIGEST_LEN) != 0)
+        return CHAIN_BAD_MERKLE;
+
+    calculateBlockHash(block, digest);
+    if (memcmp(block->hash, digest, SHA256_DIGEST_LEN) != 0)
+        return CHAIN_BAD_HASH;
+
+    if (!hashMeetsTarget(digest, target))
+        return CHAIN_BAD_TARGET;
+
+    return CHAIN_OK;
+}
+
+// 📉 Lower job->lowestBad to `height` unless a lower failure is already known
+static void recordFailure(VerifyJob *job, int height) {
+    int current = atomic_load(&job->lowestBad);
+    while (height < current && !atomic_compare_exchange_weak(&job->lowestBad, &current, height))
+        ;
+}
+
+static void *verifyWorker(void *arg) {
+    VerifyJob *job = arg;
+    int checked = 0;
+    BlockBody scratch;      // bodies not in memory are read here, not cached
+
+    for (;;) {
+        int start = atomic_fetch_add(&job->next, VERIFY_CHUNK);
+        // Nothing at or above a known failure can change the answer
+        if (start >= job->end || start >= atomic_load_explicit(&job->lowestBad, memory_order_relaxed))
+            break;
+
+        int stop = start + VERIFY_CHUNK < job->end ? start + VERIFY_CHUNK : job->end;
+        for (int h = start; h < stop; h++) {
+            ChainFault fault = checkBlock(job, h, &scratch);
+            job->faults[h - job->from] = fault;
+            checked++;
+            if (fault != CHAIN_OK) {
+                recordFailure(job, h);
+                break;
+            }
+        }
+    }
+
+    atomic_fetch_add(&job->checked, checked);
+    return NULL;
+}
+
+int verifyChainParallel(const Chain *chain, int from, int threadCount, ChainVerifyResult *result) {
+    if (from < 0)
+        from = 0;
+    if (threadCount <= 0)
+        threadCount = 1;
+
+    result->height = -1;
+    result->fault = CHAIN_OK;
+    result->checked = 0;
+    result->seconds = 0;
+    if (from >= chain->count)
+        return 1;
+
+    double start = nowSeconds();
+
+    VerifyJob job;
+    job.chain = chain;
+    bitsToTarget(chainMinimumBits(chain), job.minimumTarget);
+    job.from = from;
+    job.end = chain->count;
+    atomic_init(&job.next, from);
+    atomic_init(&job.lowestBad, chain->count);
+    atomic_init(&job.checked, 0);
+    job.faults = malloc(sizeof(ChainFault) * (chain->count - from));
+    if (!job.faults) {
+        fprintf(stderr, "❌ Out of memory verifying %d blocks\n", chain->count - from);
+        result->height = from;
+        result->fault = CHAIN_BAD_HASH;
+        return 0;
+    }
+
+    // No point starting more workers than there are chunks
+    int chunks = (chain->count - from + VERIFY_CHUNK - 1) / VERIFY_CHUNK;
+    if (threadCount > chunks)
+        threadCount = chunks;
+
+    pthread_t *threads = malloc(sizeof(pthread_t) * threadCount);
+    int started = 0;
+    if (threads) {
+        // The calling thread is one of the workers
+        for (int i = 1; i < threadCount; i++) {
+            if (pthread_create(&threads[started], NULL, verifyWorker, &job) != 0)
+                break;
+            started++;
+        }
+    }
+    verifyWorker(&job);
+    for (int i = 0; i < started; i++)
+        pthread_join(threads[i], NULL);
+    free(threads);
+
+    int bad = atomic_load(&job.lowestBad);
+
+    // 🔗 Linkage: block `from` links to the block before the range (or to
+    // all zeros at genesis); only heights below the first bad block matter
+    uint8_t prevHash[SHA256_DIGEST_LEN];
+    if (from == 0)
+        memset(prevHash, 0, SHA256_DIGEST_LEN);
+    else
+        memcpy(prevHash, chain->headers[from - 1].hash, SHA256_DIGEST_LEN);
+
+    for (int h = from; h <= bad && h < chain->count; h++) {
+        if (memcmp(chain->headers[h].previousHash, prevHash, SHA256_DIGEST_LEN) != 0) {
+            result->height = h;
+            result->fault = CHAIN_BAD_LINK;
+            break;
+        }
+        if (h == bad) {
+            result->height = h;
+            result->fault = job.faults[h - from];
+            break;
+        }
+        memcpy(prevHash, chain->headers[h].hash, SHA256_DIGEST_LEN);
+    }
+
+    result->checked = atomic_load(&job.checked);
+    result->seconds = nowSeconds() - start;
+    free(job.faults);
+    return result->height < 0;
+}
+
+int verifyChainIncremental(Chain *chain, int threadCount, ChainVerifyResult *result) {
+    if (chain->verified > chain->count)
+        chain->verified = chain->count;
+
+    int valid = verifyChainParallel(chain, chain->verified, threadCount, result);
+    chain->verified = valid ? chain->count : result->height;
+    return valid;
+}
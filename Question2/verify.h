@@ -0,0 +1,45 @@
+#ifndef VERIFY_H
+#define VERIFY_H
+
+#include "chain.h"
+
+// 🩺 Why a block failed verification
+typedef enum ChainFault {
+    CHAIN_OK = 0,
+    CHAIN_BAD_MERKLE,       // transactions do not match the header's merkleRoot
+    CHAIN_BAD_HASH,         // stored hash is not the hash of the header
+    CHAIN_BAD_TARGET,       // hash does not meet the target in bits
+    CHAIN_EASY_TARGET,      // bits declare a target easier than the chain allows
+    CHAIN_BAD_INDEX,        // header index is not the block's height
+    CHAIN_BAD_LINK          // previousHash is not the prior block's hash
+} ChainFault;
+
+typedef struct ChainVerifyResult {
+    int height;             // lowest invalid height, or -1 if the chain is valid
+    ChainFault fault;
+    int checked;            // blocks rehashed by this run
+    double seconds;
+} ChainVerifyResult;
+
+const char *chainFaultMessage(ChainFault fault);
+
+// ✅ Verify blocks [from, chain->count) with `threadCount` workers.
+//
+// Every block is checked on its own (index, merkle root, header hash, and
+// a target no easier than chain->minimumBits that the hash meets), so
+// workers take chunks of heights from a shared counter and rehash them in
+// parallel. A serial pass over previousHash follows; it only compares
+// stored hashes, which the first pass has just proven correct. Workers
+// skip heights above the lowest failure found so far, and the reported
+// height is always the lowest invalid one. Blocks are only read.
+//
+// Returns 1 if every block in the range is valid.
+int verifyChainParallel(const Chain *chain, int from, int threadCount, ChainVerifyResult *result);
+
+// 📌 Verify only what the checkpoint does not already cover, i.e. blocks
+// [chain->verified, chain->count), then move the checkpoint: to the end of
+// the chain on success, or to the first invalid height on failure. After
+// an append this rehashes just the new block.
+int verifyChainIncremental(Chain *chain, int threadCount, ChainVerifyResult *result);
+
+#endif
@@ -0,0 +1,356 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+
+// 🧪 Workload Generator
+//
+// Writes a seeded, reproducible workload in the batch format read by every
+// simulator's --batch mode:
+//
+//   utxo     users (funded with 60 each) then transfers between addresses
+//            for Question1/task1/utxo_simulation
+//   account  accounts with a starting balance, then transfers between
+//            names, for Question1/task2/account_model_simulation
+//   mining   transfers queued into blocks, with occasional bursts of extra
+//            blocks, for Question2's task1-task4
+//
+// Senders and receivers follow a Zipf distribution over the users, so a
+// few popular addresses collect many small outputs. "Conflicts" are
+// transactions the simulator must reject: a double spend of an already
+// spent UTXO in the utxo model, an overdraft in the account model.
+// The same options and seed always give the same file.
+//
+//   ./workload_gen --model utxo|account|mining [-o file] [--seed N]
+//                  [--users N] [--txs N] [--zipf S] [--receiver-zipf S]
+//                  [--amount uniform:MIN:MAX|exp:MEAN|pareto:MIN:ALPHA]
+//                  [--conflict RATE] [--balance AMOUNT]
+//                  [--per-block N] [--burst-rate RATE] [--burst-len N]
+
+typedef enum { MODEL_UTXO, MODEL_ACCOUNT, MODEL_MINING } Model;
+typedef enum { AMOUNT_UNIFORM, AMOUNT_EXP, AMOUNT_PARETO } AmountKind;
+
+typedef struct Options {
+    Model model;
+    const char *output;
+    uint64_t seed;
+    int users;
+    long txs;
+    double senderZipf;          // 0 = uniform
+    double receiverZipf;
+    AmountKind amountKind;
+    double amountA, amountB;    // min/max, mean, or min/alpha
+    double conflictRate;
+    double balance;             // account model starting balance
+    int perBlock;               // mining: transactions per block
+    double burstRate;           // mining: chance of a burst after a block
+    int burstLen;               // mining: extra blocks per burst
+} Options;
+
+#define UTXO_INITIAL_CENTS 6000     // initialize_user_utxos(60.0)
+
+// 🎲 splitmix64: small, fast and identical on every platform
+static uint64_t rngState;
+
+static uint64_t nextRandom(void) {
+    uint64_t z = (rngState += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Uniform in [0, 1)
+static double uniform01(void) {
+    return (nextRandom() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// 📈 Cumulative Zipf weights 1/k^s over `n` ranks (NULL when s == 0)
+static double *buildZipf(int n, double s) {
+    if (s <= 0)
+        return NULL;
+    double *cdf = malloc(sizeof(double) * n);
+    if (!cdf) {
+        fprintf(stderr, "❌ Out of memory for %d users\n", n);
+        exit(1);
+    }
+    double total = 0;
+    for (int k = 0; k < n; k++) {
+        total += 1.0 / pow(k + 1, s);
+        cdf[k] = total;
+    }
+    for (int k = 0; k < n; k++)
+        cdf[k] /= total;
+    return cdf;
+}
+
+// 👤 Draw a user: rank k of the Zipf table, or uniform
+static int pickUser(const double *cdf, int n) {
+    double u = uniform01();
+    if (!cdf)
+        return (int)(u * n);
+    int lo = 0, hi = n - 1;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (cdf[mid] < u)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+static int pickReceiver(const Options *o, const double *cdf, int sender) {
+    int receiver = pickUser(cdf, o->users);
+    if (receiver == sender)
+        receiver = (receiver + 1 + (int)(uniform01() * (o->users - 1))) % o->users;
+    return receiver;
+}
+
+// 💰 Draw an amount in cents (at least one cent)
+static long drawAmount(const Options *o) {
+    double amount;
+    switch (o->amountKind) {
+        case AMOUNT_EXP:
+            amount = -o->amountA * log(1.0 - uniform01());
+            break;
+        case AMOUNT_PARETO:
+            amount = o->amountA / pow(1.0 - uniform01(), 1.0 / o->amountB);
+            break;
+        default:
+            amount = o->amountA + (o->amountB - o->amountA) * uniform01();
+    }
+    long cents = (long)(amount * 100 + 0.5);
+    return cents > 0 ? cents : 1;
+}
+
+static void printAmount(FILE *out, long cents) {
+    fprintf(out, "%ld.%02ld", cents / 100, cents % 100);
+}
+
+// 🪙 UTXO model
+//
+// Which outputs a transaction spends depends on the simulator's
+// --coin-select strategy, so the generator only tracks balances. A valid
+// transaction never asks for more than the sender holds. Conflicts have to
+// be invalid under every strategy: once a transaction has spent a sender's
+// whole balance, every output the sender had, including its funding
+// output TX<n>:0, is known to be spent, so a conflict double spends that;
+// a sender never drained overdraws instead.
+// Find a sender with money, starting from a (possibly Zipf) draw
+static int pickFundedSender(const Options *o, const double *cdf, const long *balance) {
+    for (int tries = 0; tries < 64; tries++) {
+        int user = pickUser(cdf, o->users);
+        if (balance[user] > 0)
+            return user;
+    }
+    int start = (int)(uniform01() * o->users);
+    for (int i = 0; i < o->users; i++)
+        if (balance[(start + i) % o->users] > 0)
+            return (start + i) % o->users;
+    return -1;
+}
+
+static void generateUtxo(const Options *o, FILE *out, const double *senders, const double *receivers) {
+    long *balance = malloc(sizeof(long) * o->users);        // cents
+    char *drained = calloc(o->users, 1);                    // funding output spent for sure
+    for (int u = 0; u < o->users; u++) {
+        balance[u] = UTXO_INITIAL_CENTS;
+        fprintf(out, "user user%d\n", u + 1);
+    }
+
+    for (long t = 0; t < o->txs; t++) {
+        int sender = pickFundedSender(o, senders, balance);
+        if (sender < 0)
+            break;
+        int receiver = pickReceiver(o, receivers, sender);
+
+        if (uniform01() < o->conflictRate) {
+            // Double spend the sender's funding output, or overdraw
+            fprintf(out, "tx ADDRESS%d ADDRESS%d ", sender + 1, receiver + 1);
+            if (drained[sender]) {
+                printAmount(out, 1);
+                fprintf(out, " TX%d:0\n", sender + 1);        // funding is TX1..TXn
+            } else {
+                printAmount(out, balance[sender] + 1);
+                fputc('\n', out);
+            }
+            continue;
+        }
+
+        long cents = drawAmount(o);
+        if (cents >= balance[sender]) {
+            cents = balance[sender];
+            drained[sender] = 1;
+        }
+        balance[sender] -= cents;
+        balance[receiver] += cents;
+
+        fprintf(out, "tx ADDRESS%d ADDRESS%d ", sender + 1, receiver + 1);
+        printAmount(out, cents);
+        fputc('\n', out);
+    }
+
+    free(balance);
+    free(drained);
+}
+
+// 🏦 Account model: balances only, conflicts overdraw
+static void generateAccount(const Options *o, FILE *out, const double *senders, const double *receivers) {
+    long *balance = malloc(sizeof(long) * o->users);
+    long start = (long)(o->balance * 100 + 0.5);
+    for (int u = 0; u < o->users; u++) {
+        balance[u] = start;
+        fprintf(out, "user user%d ", u + 1);
+        printAmount(out, start);
+        fputc('\n', out);
+    }
+
+    for (long t = 0; t < o->txs; t++) {
+        int conflict = uniform01() < o->conflictRate;
+        int sender = conflict ? pickUser(senders, o->users) : pickFundedSender(o, senders, balance);
+        if (sender < 0)
+            break;
+        int receiver = pickReceiver(o, receivers, sender);
+
+        long cents = drawAmount(o);
+        if (conflict) {
+            cents = balance[sender] + cents;
+        } else {
+            if (cents > balance[sender])
+                cents = balance[sender];
+            balance[sender] -= cents;
+            balance[receiver] += cents;
+        }
+        fprintf(out, "tx user%d user%d ", sender + 1, receiver + 1);
+        printAmount(out, cents);
+        fputc('\n', out);
+    }
+    free(balance);
+}
+
+// ⛏️ Mining: transfers grouped into blocks, plus bursts of extra blocks
+static void generateMining(const Options *o, FILE *out, const double *senders, const double *receivers) {
+    for (long t = 0; t < o->txs; t++) {
+        int sender = pickUser(senders, o->users);
+        int receiver = pickReceiver(o, receivers, sender);
+        fprintf(out, "tx user%d user%d ", sender + 1, receiver + 1);
+        printAmount(out, drawAmount(o));
+        fputc('\n', out);
+
+        if ((t + 1) % o->perBlock == 0 || t + 1 == o->txs) {
+            fprintf(out, "block\n");
+            if (uniform01() < o->burstRate) {
+                for (int b = 0; b < o->burstLen; b++) {
+                    int user = pickUser(receivers, o->users);
+                    fprintf(out, "block coinbase -> user%d: 50\n", user + 1);
+                }
+            }
+        }
+    }
+}
+
+static int parseAmount(const char *arg, Options *o) {
+    if (sscanf(arg, "uniform:%lf:%lf", &o->amountA, &o->amountB) == 2 && o->amountB >= o->amountA) {
+        o->amountKind = AMOUNT_UNIFORM;
+        return 1;
+    }
+    if (sscanf(arg, "exp:%lf", &o->amountA) == 1 && o->amountA > 0) {
+        o->amountKind = AMOUNT_EXP;
+        return 1;
+    }
+    if (sscanf(arg, "pareto:%lf:%lf", &o->amountA, &o->amountB) == 2 && o->amountA > 0 && o->amountB > 0) {
+        o->amountKind = AMOUNT_PARETO;
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    Options o = {
+        .model = MODEL_UTXO, .output = NULL, .seed = 1, .users = 1000, .txs = 100000,
+        .senderZipf = 1.0, .receiverZipf = 1.0, .amountKind = AMOUNT_EXP, .amountA = 5,
+        .conflictRate = 0, .balance = 100, .perBlock = 10, .burstRate = 0, .burstLen = 5,
+    };
+
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        const char *value = i + 1 < argc ? argv[i + 1] : NULL;
+        if (!value) {
+            fprintf(stderr, "❌ Missing value for %s\n", arg);
+            return 1;
+        }
+        i++;
+        if (strcmp(arg, "--model") == 0) {
+            if (strcmp(value, "utxo") == 0) o.model = MODEL_UTXO;
+            else if (strcmp(value, "account") == 0) o.model = MODEL_ACCOUNT;
+            else if (strcmp(value, "mining") == 0) o.model = MODEL_MINING;
+            else {
+                fprintf(stderr, "❌ Unknown model %s\n", value);
+                return 1;
+            }
+        } else if (strcmp(arg, "-o") == 0) {
+            o.output = value;
+        } else if (strcmp(arg, "--seed") == 0) {
+            o.seed = strtoull(value, NULL, 10);
+        } else if (strcmp(arg, "--users") == 0) {
+            o.users = atoi(value);
+        } else if (strcmp(arg, "--txs") == 0) {
+            o.txs = atol(value);
+        } else if (strcmp(arg, "--zipf") == 0) {
+            o.senderZipf = atof(value);
+        } else if (strcmp(arg, "--receiver-zipf") == 0) {
+            o.receiverZipf = atof(value);
+        } else if (strcmp(arg, "--amount") == 0) {
+            if (!parseAmount(value, &o)) {
+                fprintf(stderr, "❌ Bad amount distribution %s\n", value);
+                return 1;
+            }
+        } else if (strcmp(arg, "--conflict") == 0) {
+            o.conflictRate = atof(value);
+        } else if (strcmp(arg, "--balance") == 0) {
+            o.balance = atof(value);
+        } else if (strcmp(arg, "--per-block") == 0) {
+            o.perBlock = atoi(value);
+        } else if (strcmp(arg, "--burst-rate") == 0) {
+            o.burstRate = atof(value);
+        } else if (strcmp(arg, "--burst-len") == 0) {
+            o.burstLen = atoi(value);
+        } else {
+            fprintf(stderr, "❌ Unknown option %s\n", arg);
+            return 1;
+        }
+    }
+    if (o.users < 2 || o.txs < 0 || o.perBlock < 1) {
+        fprintf(stderr, "❌ Need at least 2 users and 1 transaction per block\n");
+        return 1;
+    }
+
+    FILE *out = o.output ? fopen(o.output, "w") : stdout;
+    if (!out) {
+        fprintf(stderr, "❌ Cannot write %s\n", o.output);
+        return 1;
+    }
+
+    // The command line is enough to regenerate the file
+    fprintf(out, "# workload_gen");
+    for (int i = 1; i < argc; i++)
+        fprintf(out, " %s", argv[i]);
+    fputc('\n', out);
+
+    rngState = o.seed;
+    double *senders = buildZipf(o.users, o.senderZipf);
+    double *receivers = buildZipf(o.users, o.receiverZipf);
+
+    switch (o.model) {
+        case MODEL_UTXO: generateUtxo(&o, out, senders, receivers); break;
+        case MODEL_ACCOUNT: generateAccount(&o, out, senders, receivers); break;
+        case MODEL_MINING: generateMining(&o, out, senders, receivers); break;
+    }
+
+    free(senders);
+    free(receivers);
+    if (out != stdout)
+        fclose(out);
+    return 0;
+}